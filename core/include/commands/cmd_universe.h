@@ -1,10 +1,14 @@
 #pragma once
 #include "commands/commands.h"
 #include "universe/universe.h"
+#include "universe/sim_state.h"
 
 namespace commands {
 
-// Registers: system, gates, route, nearby
-void register_universe_commands(Router& r, const universe::Universe& u);
+// Registers: system, gates, find, route, route_avoid, routes, safe_route, chokepoints, hubs, nearby, ftl, bodies
+// With `sim`, system reports the dynamic fields (owner, stock, fleets) of
+// the last published tick instead of the universe's initial owner.
+void register_universe_commands(Router& r, const universe::Universe& u,
+                                const universe::SimStateStore* sim = nullptr);
 
 } // namespace commands
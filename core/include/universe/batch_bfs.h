@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace universe {
+
+class GateNetwork;
+using NodeIndex = int32_t;
+
+// Sources swept together by one bit-parallel pass: 64 per machine word,
+// four words (256 lanes) when built with AVX2.
+#if defined(__AVX2__)
+inline constexpr int kBatchWords = 4;
+#else
+inline constexpr int kBatchWords = 1;
+#endif
+inline constexpr int kBatchLanes = 64 * kBatchWords;
+
+// Row-major sources x targets jump counts, -1 = unreachable.
+struct JumpMatrix {
+    int rows = 0;
+    int cols = 0;
+    std::vector<int32_t> jumps;
+
+    int32_t at(int r, int c) const { return jumps[static_cast<size_t>(r) * static_cast<size_t>(cols) + static_cast<size_t>(c)]; }
+};
+
+// Many-to-many jump distances over a frozen network. Sources are swept
+// kBatchLanes at a time with per-node frontier/visited bitsets; batches run
+// in parallel and stop early once every target is resolved.
+JumpMatrix batch_jump_distances(const GateNetwork& g,
+                                std::span<const NodeIndex> sources,
+                                std::span<const NodeIndex> targets,
+                                unsigned threads = 0);
+
+// All-pairs distances into out[src * N + dst] (N = node_count), 0xFF for
+// unreachable. Returns false if some distance does not fit in a byte.
+bool batch_all_pairs_u8(const GateNetwork& g, uint8_t* out, unsigned threads = 0);
+
+} // namespace universe
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "universe/gate_network.h"
+
+namespace universe {
+
+struct ChokepointReport {
+    // Gates whose loss splits the network, as (lower id, higher id).
+    std::vector<std::pair<SystemId, SystemId>> bridges;
+    // Systems whose loss splits the network, ascending by id.
+    std::vector<SystemId> articulation_points;
+};
+
+// Tarjan's low-link pass (iterative, so deep frontier chains can't overflow
+// the stack). O(V + E) over a frozen network.
+ChokepointReport find_chokepoints(const GateNetwork& g);
+
+// Brandes betweenness per dense index (undirected, unnormalized). Sources
+// are split into fixed blocks spread over worker threads; the result is
+// bit-identical whatever the thread count. O(V * E).
+std::vector<double> betweenness_centrality(const GateNetwork& g, unsigned threads = 0);
+
+// Lazily computed, shared analytics for one network. Results are cached
+// until the network's topology version changes. Thread-safe: each result
+// is computed outside any lock by its first caller, and callers asking for
+// the same version wait on that computation, so a slow betweenness pass
+// never holds up chokepoints().
+class GateAnalytics {
+public:
+    explicit GateAnalytics(const GateNetwork& g, unsigned threads = 0) : g_(&g), threads_(threads) {}
+
+    std::shared_ptr<const ChokepointReport> chokepoints() const;
+    std::shared_ptr<const std::vector<double>> betweenness() const;
+
+private:
+    const GateNetwork* g_;
+    unsigned threads_;
+
+    template <class T>
+    struct Cache {
+        std::mutex mu; // guards version and result, never held while computing
+        uint64_t version = 0;
+        std::shared_future<std::shared_ptr<const T>> result;
+    };
+    mutable Cache<ChokepointReport> chokepoints_;
+    mutable Cache<std::vector<double>> betweenness_;
+
+    template <class T, class Fn>
+    std::shared_ptr<const T> cached(Cache<T>& cache, Fn&& compute) const;
+};
+
+} // namespace universe
@@ -2,18 +2,38 @@
 #include <cstdint>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <optional>
+#include <span>
+
+#include "universe/batch_bfs.h"
+#include "universe/gate_overlay.h"
+#include "universe/region_index.h"
+#include "universe/route_table.h"
 
 namespace universe {
 
 using SystemId = int32_t;
 
+// Dense node index, 0..node_count()-1 in insertion order.
+using NodeIndex = int32_t;
+
 struct RouteResult {
     int jumps{0};
     std::vector<SystemId> path; // includes start and goal
 };
 
+// Optional indexes built by GateNetwork::freeze().
+struct FreezeOptions {
+    bool route_table = true;            // all-pairs table, 2*N*N bytes
+    int route_table_max_nodes = 4096;
+    bool region_index = true;           // hierarchical index for large networks
+    int region_index_min_nodes = 20000; // below this plain BFS is fast enough
+    int region_size = 64;
+    unsigned threads = 0;               // 0 = hardware concurrency
+};
+
+class SnapshotCodec;
+
 class GateNetwork {
 public:
     // Node management (optional, but helps validate)
@@ -24,36 +44,132 @@ public:
     bool add_gate(SystemId a, SystemId b);      // undirected
     bool has_gate(SystemId a, SystemId b) const;
 
-    const std::vector<SystemId>& neighbors(SystemId id) const;
+    std::span<const SystemId> neighbors(SystemId id) const;
 
     int gate_count() const { return gate_count_; }
-    int node_count() const { return static_cast<int>(adj_.size()); }
+    int node_count() const { return static_cast<int>(ids_.size()); }
+
+    // Bumped by every add_node / add_gate that changes the graph; lets
+    // derived data (analytics caches) detect that it is stale.
+    uint64_t topology_version() const { return topology_version_; }
+
+    // Compiled mode: packs adjacency into CSR arrays (offsets + one contiguous
+    // neighbor array over dense indices) and builds the optional indexes.
+    // All queries use it once frozen.
+    //
+    // Edits on a frozen network recompile the CSR in O(V + E) but drop the
+    // route table and region index, which cost a BFS per source to rebuild;
+    // queries fall back to BFS until freeze() is called again. Apply a batch
+    // of edits, then freeze() once.
+    void freeze(const FreezeOptions& opts = {});
+    bool frozen() const { return frozen_; }
+
+    // nullptr unless freeze() built the all-pairs table.
+    const RouteTable* route_table() const { return route_table_.empty() ? nullptr : &route_table_; }
+
+    // nullptr unless freeze() built the region index (large networks with
+    // no route table). shortest_route prefers table, then regions, then BFS.
+    const RegionIndex* region_index() const { return region_index_.empty() ? nullptr : &region_index_; }
+
+    // Dense index <-> SystemId
+    std::optional<NodeIndex> index_of(SystemId id) const;
+    SystemId id_at(NodeIndex i) const { return ids_[static_cast<size_t>(i)]; }
+
+    // CSR neighbor list of a dense index (frozen only).
+    std::span<const NodeIndex> dense_neighbors(NodeIndex i) const {
+        return {targets_.data() + offsets_[i], targets_.data() + offsets_[i + 1]};
+    }
+
+    // Dense gate ids (0..gate_count()-1) parallel to dense_neighbors (frozen
+    // only). A gate's id is its position in add_gate order and never changes,
+    // so ids held elsewhere (GateOverlay bits) survive later edits.
+    std::span<const EdgeIndex> dense_edges(NodeIndex i) const {
+        return {edge_ids_.data() + offsets_[i], edge_ids_.data() + offsets_[i + 1]};
+    }
+    std::optional<EdgeIndex> edge_index(SystemId a, SystemId b) const;
+
+    // Queries optionally run against an overlay of closed systems / gates
+    // (frozen only; an overlay on an unfrozen network finds nothing). Closed
+    // systems are never entered, but a route may start in one. Overlay
+    // queries bypass the route table and region index.
+    std::optional<RouteResult> shortest_route(SystemId start, SystemId goal,
+                                              const GateOverlay* overlay = nullptr) const;
+    std::vector<SystemId> within(SystemId start, int max_jumps, bool include_start = false,
+                                 const GateOverlay* overlay = nullptr) const;
 
-    std::optional<RouteResult> shortest_route(SystemId start, SystemId goal) const;
-    std::vector<SystemId> within(SystemId start, int max_jumps, bool include_start = false) const;
+    // Batch queries. jump_distances sweeps many sources at once with the
+    // bit-parallel engine (frozen only; all -1 otherwise). within_any is a
+    // multi-source BFS and includes the sources themselves.
+    JumpMatrix jump_distances(std::span<const SystemId> sources, std::span<const SystemId> targets) const;
+    std::vector<SystemId> within_any(std::span<const SystemId> sources, int max_jumps) const;
 
-    bool is_connected() const;
+    // Up to k loopless routes in order of jumps (Yen's algorithm). Spur
+    // searches share one GateOverlay and the thread's search workspace, so
+    // the graph is never copied. Frozen only.
+    std::vector<RouteResult> k_shortest_routes(SystemId start, SystemId goal, int k,
+                                               const GateOverlay* overlay = nullptr) const;
+
+    // Connectivity, kept incrementally by a union-find updated in
+    // add_node/add_gate. component_of returns the component's representative.
+    bool is_connected() const { return components_ <= 1; }
+    int component_count() const { return components_; }
+    std::optional<SystemId> component_of(SystemId id) const;
 
 private:
-    std::unordered_map<SystemId, std::vector<SystemId>> adj_;
-
-    struct Edge { SystemId a, b; };
-    struct EdgeHash {
-        size_t operator()(const Edge& e) const noexcept {
-            return (static_cast<size_t>(e.a) << 32) ^ static_cast<size_t>(e.b);
-        }
-    };
-    struct EdgeEq {
-        bool operator()(const Edge& x, const Edge& y) const noexcept {
-            return x.a == y.a && x.b == y.b;
-        }
-    };
-
-    std::unordered_set<Edge, EdgeHash, EdgeEq> edges_;
+    friend class SnapshotCodec; // reads and adopts the CSR arrays directly
+
+    // Dense index map. While ids arrive as one contiguous run (the usual
+    // 1..N case) index_of() is plain arithmetic and index_ stays empty.
+    std::vector<SystemId> ids_;
+    std::unordered_map<SystemId, NodeIndex> index_;
+    bool contiguous_ = true;
+
+    // Mutable builder adjacency (dense index -> neighbor ids, and the gate id
+    // of each, parallel). Released on freeze().
+    std::vector<std::vector<SystemId>> adj_;
+    std::vector<std::vector<EdgeIndex>> adj_edges_;
+
+    // Compiled CSR adjacency: neighbors of i are [offsets_[i], offsets_[i + 1]).
+    bool frozen_ = false;
+    std::vector<int32_t> offsets_;
+    std::vector<NodeIndex> targets_;
+    std::vector<SystemId> target_ids_;
+    std::vector<EdgeIndex> edge_ids_;
+
+    FreezeOptions freeze_opts_;
+    RouteTable route_table_;
+    RegionIndex region_index_;
+
     int gate_count_ = 0;
+    uint64_t topology_version_ = 0;
+
+    // Union-find over dense indices (union by rank, path compression on
+    // edits; freeze() flattens it so const lookups are one hop).
+    std::vector<NodeIndex> uf_parent_;
+    std::vector<uint8_t> uf_rank_;
+    int components_ = 0;
+
+    NodeIndex uf_find(NodeIndex i);
+    void uf_union(NodeIndex a, NodeIndex b);
+    NodeIndex uf_root(NodeIndex i) const;
+
+    void thaw();
+    void compile(); // CSR from the builder adjacency; no indexes
+    void build_indexes();
+
+    // Bidirectional BFS over dense indices, skipping whatever `overlay`
+    // disables (frozen only when non-null). Fills `path` start..goal.
+    bool bidirectional_path(NodeIndex s, NodeIndex g, const GateOverlay* overlay,
+                            std::vector<NodeIndex>& path) const;
+
+    RouteResult to_route(std::span<const NodeIndex> path) const;
+
+    template <class Fn>
+    void for_each_neighbor(NodeIndex i, Fn&& fn) const;
+    template <class Fn>
+    void for_each_open_neighbor(NodeIndex i, const GateOverlay* overlay, Fn&& fn) const;
 
-    static Edge norm(SystemId a, SystemId b);
-    static const std::vector<SystemId>& empty_neighbors();
+    EdgeIndex edge_between(NodeIndex a, NodeIndex b) const; // -1 if none
 };
 
 } // namespace universe
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace universe {
+
+class GateNetwork;
+using SystemId = int32_t;
+using NodeIndex = int32_t;
+using EdgeIndex = int32_t;
+
+// A view of a frozen GateNetwork with some systems and gates switched off.
+// Two bitsets over dense node / edge ids: the graph itself is never copied,
+// and bits outside the sized range read as enabled. Edits to the network
+// only append ids, so an overlay stays valid across them and new systems
+// and gates start enabled.
+class GateOverlay {
+public:
+    GateOverlay() = default;
+    explicit GateOverlay(const GateNetwork& g);
+
+    void disable_node(NodeIndex i) { set(nodes_, static_cast<size_t>(i), true); }
+    void enable_node(NodeIndex i) { set(nodes_, static_cast<size_t>(i), false); }
+    bool node_enabled(NodeIndex i) const { return !test(nodes_, static_cast<size_t>(i)); }
+
+    void disable_edge(EdgeIndex e) { set(edges_, static_cast<size_t>(e), true); }
+    void enable_edge(EdgeIndex e) { set(edges_, static_cast<size_t>(e), false); }
+    bool edge_enabled(EdgeIndex e) const { return !test(edges_, static_cast<size_t>(e)); }
+
+    // SystemId helpers; false if the system or gate does not exist.
+    bool close_system(const GateNetwork& g, SystemId id);
+    bool open_system(const GateNetwork& g, SystemId id);
+    bool close_gate(const GateNetwork& g, SystemId a, SystemId b);
+    bool open_gate(const GateNetwork& g, SystemId a, SystemId b);
+
+    void clear();
+
+private:
+    std::vector<uint64_t> nodes_; // set bit = disabled
+    std::vector<uint64_t> edges_;
+
+    static bool test(const std::vector<uint64_t>& bits, size_t i) {
+        return (i >> 6) < bits.size() && (bits[i >> 6] >> (i & 63)) & 1;
+    }
+    static void set(std::vector<uint64_t>& bits, size_t i, bool on) {
+        if ((i >> 6) >= bits.size()) {
+            if (!on) return;
+            bits.resize((i >> 6) + 1, 0);
+        }
+        uint64_t m = uint64_t{1} << (i & 63);
+        bits[i >> 6] = on ? (bits[i >> 6] | m) : (bits[i >> 6] & ~m);
+    }
+};
+
+} // namespace universe
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace universe {
+
+using SystemId = int32_t;
+class SnapshotCodec;
+
+// Case-insensitive system name lookup. Folded names live in one arena;
+// exact matches go through an open-addressing table of entry numbers and
+// prefix queries binary-search a sorted array of them. Queries fold on the
+// fly, so lookups never allocate. Names are ASCII-folded ("Sys-01" == "sys-01").
+class NameIndex {
+public:
+    // False if a system with the same folded name is already indexed.
+    bool add(std::string_view name, SystemId id);
+
+    std::optional<SystemId> find(std::string_view name) const;
+
+    // Up to `limit` systems whose folded name starts with `prefix`, in name order.
+    std::vector<SystemId> find_prefix(std::string_view prefix, size_t limit) const;
+
+    size_t size() const { return ids_.size(); }
+    size_t memory_bytes() const;
+
+    static char fold(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+private:
+    friend class SnapshotCodec;
+
+    std::string folded_;                 // entry e is folded_[offsets_[e], offsets_[e + 1])
+    std::vector<uint32_t> offsets_{0};
+    std::vector<SystemId> ids_;          // entry -> system
+    std::vector<uint32_t> slots_;        // hash table of entry + 1, 0 = empty
+    std::vector<uint32_t> sorted_;       // entries in name order
+
+    std::string_view key(uint32_t e) const {
+        return std::string_view(folded_).substr(offsets_[e], offsets_[e + 1] - offsets_[e]);
+    }
+
+    static uint64_t hash(std::string_view name);
+    std::optional<uint32_t> lookup(std::string_view name) const;
+    void grow();
+};
+
+} // namespace universe
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace universe {
+
+class GateNetwork;
+using NodeIndex = int32_t;
+
+// Two-level routing index for networks too large for the all-pairs table.
+// The graph is cut into regions of bounded size (BFS-grown from seeds); a
+// system with a gate into another region is a border. Per region, in-region
+// jump distances between all of its borders are precomputed, which together
+// with the cross-region gates forms a small weighted overlay graph.
+//
+// A query searches the start and goal regions directly, runs A* (landmark
+// bounds) on the overlay in between and unpacks overlay hops with in-region
+// BFS, so it never touches the interior of the regions it passes through.
+class RegionIndex {
+public:
+    // Returns false (and leaves the index empty) when the graph wouldn't
+    // benefit: small-world diameter, or an overlay over its edge budget
+    // because the graph has too little locality.
+    bool build(const GateNetwork& g, int region_size, unsigned threads = 0);
+    void clear();
+
+    bool empty() const { return region_.empty(); }
+    int region_count() const { return regions_; }
+    int border_count() const { return static_cast<int>(border_nodes_.size()); }
+    size_t memory_bytes() const;
+
+    int32_t region_of(NodeIndex i) const { return region_[static_cast<size_t>(i)]; }
+
+    // Shortest route s..t over dense indices into `path`; false if unreachable.
+    bool shortest_path(const GateNetwork& g, NodeIndex s, NodeIndex t, std::vector<NodeIndex>& path) const;
+
+private:
+    int regions_ = 0;
+    std::vector<int32_t> region_;         // node -> region
+    std::vector<int32_t> overlay_id_;     // node -> overlay node, -1 if interior
+    std::vector<NodeIndex> border_nodes_; // overlay node -> node
+
+    // Overlay adjacency (CSR): in-region border cliques plus cross-region gates.
+    std::vector<int32_t> offsets_;
+    std::vector<int32_t> targets_;
+    std::vector<uint16_t> weights_;
+
+    // Jump distances to a few far-apart landmarks (node-major, 0xFFFF when
+    // unreachable); |d(L, v) - d(L, t)| bounds the overlay search from below.
+    int landmarks_ = 0;
+    std::vector<uint16_t> landmark_dist_;
+
+    void build_landmarks(const GateNetwork& g, NodeIndex start, int count);
+    uint32_t lower_bound(NodeIndex v, NodeIndex t) const;
+
+    // Folds regions under half of region_size into their best-connected neighbor.
+    void merge_fragments(const GateNetwork& g, std::vector<int32_t>& sizes, int region_size);
+
+    // In-region BFS from `from` on workspace side `side`; stops early at `stop` if given.
+    void region_bfs(const GateNetwork& g, NodeIndex from, int side, NodeIndex stop = -1) const;
+};
+
+} // namespace universe
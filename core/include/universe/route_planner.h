@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "universe/universe.h"
+
+namespace universe {
+
+// Cost of entering a system: jump_cost + security_cost[security], plus
+// border_cost when the owning faction changes across the gate.
+struct RouteCostProfile {
+    uint32_t jump_cost = 10;
+    uint32_t security_cost[4] = {0, 5, 20, 60}; // High, Medium, Low, None
+    uint32_t border_cost = 0;
+    bool avoid_lawless = false;                 // never pass through SecurityLevel::None
+};
+
+struct WeightedRoute {
+    uint64_t cost{0};
+    int jumps{0};
+    std::vector<SystemId> path; // includes start and goal
+};
+
+// Weighted, security-aware routing over a frozen gate network. A* on a radix
+// heap, guided by ALT lower bounds (triangle inequality against a handful of
+// landmark systems). Costs are snapshotted at construction; rebuild the
+// planner when security or ownership changes.
+class RoutePlanner {
+public:
+    RoutePlanner(const Universe& u, RouteCostProfile profile, int landmarks = 8);
+
+    // Optional overlay closes systems / gates for this query only; landmark
+    // bounds stay valid because closing things only makes routes longer.
+    std::optional<WeightedRoute> route(SystemId start, SystemId goal,
+                                       const GateOverlay* overlay = nullptr) const;
+
+    const RouteCostProfile& profile() const { return profile_; }
+    int landmark_count() const { return static_cast<int>(landmarks_.size()); }
+
+    // Cost of the gate hop from -> to (dense indices).
+    uint32_t edge_cost(NodeIndex from, NodeIndex to) const {
+        uint32_t c = enter_cost_[static_cast<size_t>(to)];
+        if (owner_[static_cast<size_t>(from)] != owner_[static_cast<size_t>(to)]) c += profile_.border_cost;
+        return c;
+    }
+
+    // Whether a route towards goal may enter v.
+    bool enterable(NodeIndex v, NodeIndex goal) const {
+        return v == goal || !blocked_[static_cast<size_t>(v)];
+    }
+
+private:
+    static constexpr uint32_t kInf = UINT32_MAX;
+
+    const GateNetwork* g_;
+    RouteCostProfile profile_;
+
+    std::vector<uint32_t> enter_cost_;
+    std::vector<int32_t> owner_;
+    std::vector<uint8_t> blocked_;
+
+    // lm_dist_[(v * K + k) * 2] = cost landmark k -> v, [... + 1] = cost v -> landmark k.
+    std::vector<NodeIndex> landmarks_;
+    std::vector<uint32_t> lm_dist_;
+
+    void dijkstra_all(NodeIndex src, bool reverse, std::vector<uint32_t>& out) const;
+    uint32_t lower_bound(NodeIndex v, NodeIndex goal) const;
+};
+
+} // namespace universe
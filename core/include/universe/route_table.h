@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace universe {
+
+class GateNetwork;
+using NodeIndex = int32_t;
+
+// Precomputed all-pairs jump distances and next hops over a frozen
+// GateNetwork's dense indices. N*N bytes each; ~500 KB total at 500 systems.
+class RouteTable {
+public:
+    static constexpr uint8_t kUnreachable = 0xFF;
+
+    // Fills distances with the bit-parallel batch BFS, then derives next hops
+    // from neighbor rows. Returns false (and leaves the table empty) if a
+    // distance or node degree does not fit in a byte.
+    bool build(const GateNetwork& g, unsigned threads = 0);
+    void clear();
+
+    bool empty() const { return n_ == 0; }
+    int size() const { return n_; }
+    size_t memory_bytes() const { return dist_.size() + next_.size(); }
+
+    uint8_t distance(NodeIndex a, NodeIndex b) const { return dist_[at(a, b)]; }
+    const uint8_t* distance_row(NodeIndex a) const { return dist_.data() + at(a, 0); }
+
+    // Position of the first hop from a towards b in a's CSR neighbor list.
+    uint8_t next_slot(NodeIndex a, NodeIndex b) const { return next_[at(a, b)]; }
+
+private:
+    int n_ = 0;
+    std::vector<uint8_t> dist_;
+    std::vector<uint8_t> next_;
+
+    size_t at(NodeIndex a, NodeIndex b) const {
+        return static_cast<size_t>(a) * static_cast<size_t>(n_) + static_cast<size_t>(b);
+    }
+};
+
+} // namespace universe
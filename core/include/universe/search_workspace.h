@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace universe {
+
+using NodeIndex = int32_t;
+
+// Reusable scratch space for graph searches over dense node indices.
+// Slots are stamped with an epoch, so begin() never clears the arrays and a
+// warmed-up workspace allocates nothing. Two sides support bidirectional BFS.
+class SearchWorkspace {
+public:
+    static constexpr int kSides = 2;
+
+    // Starts a new search over `node_count` nodes.
+    void begin(size_t node_count);
+
+    bool seen(NodeIndex i, int side = 0) const {
+        return slots_[side][static_cast<size_t>(i)].stamp == epoch_;
+    }
+
+    void visit(NodeIndex i, int32_t dist, NodeIndex parent, int side = 0) {
+        slots_[side][static_cast<size_t>(i)] = Slot{epoch_, dist, parent};
+    }
+
+    int32_t dist(NodeIndex i, int side = 0) const { return slots_[side][static_cast<size_t>(i)].dist; }
+    NodeIndex parent(NodeIndex i, int side = 0) const { return slots_[side][static_cast<size_t>(i)].parent; }
+
+    // Per-side FIFO storage, emptied by begin().
+    std::vector<NodeIndex>& queue(int side = 0) { return queue_[side]; }
+
+    // Workspace owned by the calling thread.
+    static SearchWorkspace& local();
+
+private:
+    struct Slot {
+        uint32_t stamp;
+        int32_t dist;
+        NodeIndex parent;
+    };
+
+    uint32_t epoch_ = 0;
+    std::vector<Slot> slots_[kSides];
+    std::vector<NodeIndex> queue_[kSides];
+};
+
+} // namespace universe
@@ -0,0 +1,120 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace universe {
+
+class Universe;
+
+// Per-system state the tick changes, as columns by dense system index
+// (Universe::dense_index). The static description (names, gates,
+// positions) stays in Universe.
+struct SimState {
+    int64_t tick = 0;
+    int64_t game_seconds = 0;
+
+    std::vector<int32_t> owners; // faction id, 0 = unclaimed
+    std::vector<int64_t> stock;  // stored goods, in units
+    std::vector<int32_t> fleets; // fleets present
+
+    // Initial state: owners from the universe, everything else empty.
+    static SimState from_universe(const Universe& u);
+};
+
+class SimStateStore;
+
+// A pinned, immutable tick result. Cheap to take; hold it only for the
+// duration of a read (a pinned state cannot be recycled).
+class SimSnapshot {
+public:
+    SimSnapshot(SimSnapshot&& o) noexcept : store_(o.store_), slot_(o.slot_), state_(o.state_) { o.store_ = nullptr; }
+    SimSnapshot(const SimSnapshot&) = delete;
+    SimSnapshot& operator=(const SimSnapshot&) = delete;
+    SimSnapshot& operator=(SimSnapshot&&) = delete;
+    ~SimSnapshot();
+
+    const SimState& operator*() const { return *state_; }
+    const SimState* operator->() const { return state_; }
+
+private:
+    friend class SimStateStore;
+    SimSnapshot(const SimStateStore* store, size_t slot, const SimState* state)
+        : store_(store), slot_(slot), state_(state) {}
+
+    const SimStateStore* store_;
+    size_t slot_;
+    const SimState* state_;
+};
+
+// Multi-buffered SimState: one tick thread writes the next state while any
+// number of readers see the last published one.
+//
+// publish() swaps an atomic pointer; readers pin what they load by
+// announcing the current epoch in a reader slot, and a replaced state is
+// only recycled once no slot shows an epoch from before the swap
+// (epoch-based reclamation). Recycled buffers are overwritten in place by
+// the next begin_tick(), so steady state allocates nothing. Neither side
+// waits for the other: a pinned buffer just stays retired and the writer
+// takes another.
+class SimStateStore {
+public:
+    explicit SimStateStore(SimState initial);
+    ~SimStateStore();
+
+    SimStateStore(const SimStateStore&) = delete;
+    SimStateStore& operator=(const SimStateStore&) = delete;
+
+    // Readers: any thread.
+    SimSnapshot read() const;
+
+    // Writer (one thread): begin_tick() returns a copy of the current state
+    // to modify; publish() makes it current. writing() is the buffer
+    // between the two, nullptr otherwise.
+    SimState& begin_tick(int64_t tick, int64_t game_seconds);
+    SimState* writing() { return writing_; }
+    void publish();
+
+    struct Stats {
+        uint64_t published = 0;
+        size_t buffers = 0; // allocated in total
+        size_t retired = 0; // waiting for readers to move on
+    };
+    Stats stats() const; // writer thread only
+
+private:
+    friend class SimSnapshot;
+    static constexpr size_t kReaderSlots = 64;
+    static constexpr uint64_t kIdle = 0;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{kIdle};
+    };
+    struct Retired {
+        SimState* state;
+        uint64_t epoch; // readers announced before this epoch may hold it
+    };
+
+    std::atomic<const SimState*> current_;
+    std::atomic<uint64_t> epoch_{1};
+    mutable std::array<Slot, kReaderSlots> slots_;
+
+    // Writer-only.
+    std::vector<std::unique_ptr<SimState>> owned_;
+    std::vector<SimState*> free_;
+    std::vector<Retired> retired_;
+    SimState* writing_ = nullptr;
+    uint64_t published_ = 0;
+
+    void release(size_t slot) const { slots_[slot].epoch.store(kIdle, std::memory_order_release); }
+    void reclaim();
+};
+
+inline SimSnapshot::~SimSnapshot() {
+    if (store_) store_->release(slot_);
+}
+
+} // namespace universe
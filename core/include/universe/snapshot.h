@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "universe/universe.h"
+
+namespace universe {
+
+// Binary universe snapshot. A fixed header (magic, version, byte-order mark,
+// counts, seed, checksum) is followed by a section table and 8-byte aligned
+// sections holding the system columns, the name arena, the name index's
+// folded arena / hash table / sort order and the gate CSR arrays, each in
+// its in-memory layout. Everything after the header is checksummed.
+//
+// Loading maps the file and bulk-copies each section into place: nothing is
+// parsed, hashed or re-sorted, and gates are adopted as CSR without replaying
+// add_gate. Optional gate indexes (route table, region index) are rebuilt
+// per `opts`, and the spatial index is rebuilt from the positions.
+constexpr uint32_t kSnapshotVersion = 2; // 2: system positions
+
+// Writes atomically (temp file + rename). On failure returns false and, if
+// `error` is non-null, a short reason.
+bool save_snapshot(const Universe& u, const std::string& path, std::string* error = nullptr);
+
+std::optional<Universe> load_snapshot(const std::string& path, const FreezeOptions& opts = {},
+                                      std::string* error = nullptr);
+
+} // namespace universe
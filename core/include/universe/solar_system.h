@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <string>
+#include "universe/vec3.h"
 
 namespace universe {
 
@@ -17,6 +18,8 @@ struct SolarSystem {
     SecurityLevel security{SecurityLevel::Low};
 
     int32_t owner_faction_id{0}; // 0 = unclaimed
+
+    Vec3 position{};
 };
 
 } // namespace universe
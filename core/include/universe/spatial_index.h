@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "universe/vec3.h"
+
+namespace universe {
+
+// One result of a spatial query: a dense index into the indexed points and
+// its distance from the query centre (light-years).
+struct SpatialHit {
+    uint32_t index{0};
+    float distance{0};
+};
+
+// Uniform grid over a static point set (system positions). Cells are sized
+// from the bounding box so each holds a couple of points on average, and
+// points are stored cell by cell, so a query only reads the cells that
+// overlap its search sphere. Thin layouts (a galactic disk) get a single
+// layer of cells along the flat axis.
+class SpatialIndex {
+public:
+    // cell_size <= 0 picks one from the bounding box and point count.
+    void build(std::span<const Vec3> points, float cell_size = 0.0f);
+    void clear();
+    bool empty() const { return cell_start_.empty(); }
+    size_t size() const { return index_.size(); }
+
+    // Points within `radius` of `center` (inclusive), nearest first, ties by index.
+    std::vector<SpatialHit> within(const Vec3& center, float radius) const;
+
+    // The k points nearest to `center`, nearest first, ties by index. Searches
+    // outward ring by ring and stops once no unvisited cell can be closer.
+    std::vector<SpatialHit> nearest(const Vec3& center, size_t k) const;
+
+    float cell_size() const { return cell_; }
+    size_t cell_count() const { return cell_start_.empty() ? 0 : cell_start_.size() - 1; }
+    size_t memory_bytes() const;
+
+private:
+    Vec3 origin_{};
+    float cell_ = 1.0f;
+    float inv_cell_ = 1.0f;
+    int32_t dims_[3] = {0, 0, 0};
+
+    std::vector<uint32_t> cell_start_; // points of cell c are [cell_start_[c], cell_start_[c + 1])
+    std::vector<uint32_t> index_;      // point index, in cell order
+    std::vector<Vec3> points_;         // positions, in cell order
+
+    int32_t cell_coord(float v, float origin, int axis) const; // clamped to the grid
+    size_t cell_id(int32_t x, int32_t y, int32_t z) const {
+        return (static_cast<size_t>(z) * static_cast<size_t>(dims_[1]) + static_cast<size_t>(y)) *
+                   static_cast<size_t>(dims_[0]) + static_cast<size_t>(x);
+    }
+};
+
+} // namespace universe
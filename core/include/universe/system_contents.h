@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "universe/universe.h"
+
+namespace universe {
+
+enum class BodyType : uint8_t { Planet, Moon, AsteroidBelt };
+enum class BodyClass : uint8_t { None, Lava, Rocky, Desert, Ocean, Ice, GasGiant };
+
+struct Body {
+    BodyType type{BodyType::Planet};
+    BodyClass body_class{BodyClass::None}; // None for asteroid belts
+    int16_t parent{-1};                    // moons: index of the planet they orbit
+    float orbit_au{0};                     // distance from the star (moons: their planet's)
+    uint8_t richness{0};                   // resource richness, 0-100
+    int32_t owner_faction_id{0};           // 0 = unclaimed
+};
+
+// Bodies of one system, ordered by orbit; each moon follows its planet.
+struct SystemContents {
+    SystemId system{};
+    std::vector<Body> bodies;
+};
+
+// Pure function of (seed, system id, type): the same inputs always give the
+// same bodies, so contents never need storing.
+SystemContents generate_system_contents(uint64_t seed, SystemId id, SystemType type);
+
+// A persisted change to one generated body. Unset fields keep the
+// generated value.
+struct BodyChange {
+    SystemId system{};
+    uint16_t body{0};
+    std::optional<int32_t> owner_faction_id;
+    std::optional<uint8_t> richness;
+};
+
+// Lazy view of every system's contents. A system's bodies are generated
+// from the universe seed on first access, kept in a bounded LRU cache and
+// regenerated after eviction; only BodyChanges are stored permanently, so
+// memory follows the active set plus the modified bodies, not the universe
+// size. Thread-safe.
+class SystemContentsCache {
+public:
+    explicit SystemContentsCache(const Universe& u, size_t capacity = 4096) : u_(&u), capacity_(capacity) {}
+
+    // nullptr for unknown systems. The snapshot stays valid after eviction
+    // or later changes (those produce a new snapshot).
+    std::shared_ptr<const SystemContents> get(SystemId id);
+
+    // Merges `change` into the stored changes. False if the system or body
+    // does not exist.
+    bool apply(const BodyChange& change);
+
+    // Every stored change, by system then body (what a save needs).
+    std::vector<BodyChange> changes() const;
+
+    struct Stats {
+        size_t cached = 0;
+        size_t capacity = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0; // generations, including regenerations after eviction
+        uint64_t evictions = 0;
+        size_t changed_systems = 0;
+    };
+    Stats stats() const;
+
+private:
+    using Entry = std::pair<SystemId, std::shared_ptr<const SystemContents>>;
+
+    const Universe* u_;
+    size_t capacity_;
+
+    mutable std::mutex mu_;
+    std::list<Entry> lru_; // most recently used first
+    std::unordered_map<SystemId, std::list<Entry>::iterator> cached_;
+    std::unordered_map<SystemId, std::vector<BodyChange>> changes_;
+    uint64_t hits_ = 0, misses_ = 0, evictions_ = 0;
+
+    std::shared_ptr<const SystemContents> build(SystemId id) const; // generated + changes; needs mu_
+    void put(SystemId id, std::shared_ptr<const SystemContents> contents); // needs mu_
+};
+
+} // namespace universe
@@ -1,23 +1,118 @@
 #pragma once
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include "universe/solar_system.h"
 #include "universe/gate_network.h"
+#include "universe/name_index.h"
+#include "universe/spatial_index.h"
 
 namespace universe {
 
+// Non-owning view of one system; `name` points into the universe's name
+// arena and stays valid until the next add_system().
+struct SystemView {
+    SystemId id{};
+    std::string_view name;
+    SystemType type{SystemType::Frontier};
+    SecurityLevel security{SecurityLevel::Low};
+    int32_t owner_faction_id{0};
+    Vec3 position{};
+};
+
+// A system and its distance from a query point.
+struct SystemDistance {
+    SystemId id{};
+    float ly{0};
+};
+
+class SnapshotCodec;
+
+// Systems are stored column-wise by dense index (0..system_count()-1, in
+// insertion order): whole-universe scans read only the columns they need.
+// Names are interned into one arena.
 class Universe {
 public:
     bool add_system(SolarSystem sys);
+
+    // Owning copy (allocates the name); prefer view() on hot paths.
     std::optional<SolarSystem> get_system(SystemId id) const;
 
-    const std::unordered_map<SystemId, SolarSystem>& systems() const { return systems_; }
+    // Zero-copy accessors. name_of() is empty for unknown ids.
+    std::optional<SystemView> view(SystemId id) const;
+    std::string_view name_of(SystemId id) const;
+
+    // Bulk forms: out[i] describes ids[i] (out must be at least as long).
+    // Unknown ids yield an empty name / a default SystemView with only id set.
+    void names_of(std::span<const SystemId> ids, std::span<std::string_view> out) const;
+    void views_of(std::span<const SystemId> ids, std::span<SystemView> out) const;
+
+    // Seed the universe was generated from (0 if built by hand); lets
+    // derived content be regenerated deterministically.
+    uint64_t seed() const { return seed_; }
+    void set_seed(uint64_t seed) { seed_ = seed; }
+
     GateNetwork& gates() { return gates_; }
     const GateNetwork& gates() const { return gates_; }
-    std::optional<SystemId> find_system_by_name(const std::string& name) const;
+
+    // Case-insensitive; O(1) via the name index. If two systems share a
+    // name, the first one added wins.
+    std::optional<SystemId> find_system_by_name(std::string_view name) const;
+    std::vector<SystemId> find_systems_by_prefix(std::string_view prefix, size_t limit) const;
+
+    // Straight-line (FTL) queries, nearest first. Sub-linear once
+    // build_spatial_index() has run; add_system() drops the index and the
+    // queries fall back to a full scan until it is rebuilt.
+    void build_spatial_index(float cell_size_ly = 0.0f);
+    const SpatialIndex* spatial_index() const { return spatial_.empty() ? nullptr : &spatial_; }
+    std::vector<SystemDistance> systems_within_ly(const Vec3& center, float ly) const;
+    std::vector<SystemDistance> nearest_systems(const Vec3& center, size_t k) const;
+
+    // Dense column access.
+    size_t system_count() const { return ids_.size(); }
+    std::optional<uint32_t> dense_index(SystemId id) const;
+    SystemId id_at(uint32_t i) const { return ids_[i]; }
+    std::string_view name_at(uint32_t i) const {
+        return std::string_view(names_arena_).substr(name_offsets_[i], name_offsets_[i + 1] - name_offsets_[i]);
+    }
+    SystemView view_at(uint32_t i) const {
+        return {ids_[i], name_at(i), types_[i], security_[i], owners_[i], positions_[i]};
+    }
+    const Vec3& position_at(uint32_t i) const { return positions_[i]; }
+
+    std::span<const SystemId> ids() const { return ids_; }
+    std::span<const SystemType> types() const { return types_; }
+    std::span<const SecurityLevel> security() const { return security_; }
+    std::span<const int32_t> owners() const { return owners_; }
+    std::span<const Vec3> positions() const { return positions_; }
+
+    // Approximate heap footprint of the system store and spatial index (excludes gates).
+    size_t memory_bytes() const;
 
 private:
-    std::unordered_map<SystemId, SolarSystem> systems_;
+    friend class SnapshotCodec; // bulk-loads the columns (universe/snapshot.h)
+
+    uint64_t seed_ = 0;
+
+    std::vector<SystemId> ids_;
+    std::vector<SystemType> types_;
+    std::vector<SecurityLevel> security_;
+    std::vector<int32_t> owners_;
+    std::vector<Vec3> positions_;
+    std::string names_arena_;
+    std::vector<uint32_t> name_offsets_{0};
+
+    // Same trick as GateNetwork: while ids form one contiguous run the dense
+    // index is arithmetic and index_ stays empty.
+    std::unordered_map<SystemId, uint32_t> index_;
+    bool contiguous_ = true;
+    NameIndex names_;
+    SpatialIndex spatial_;
     GateNetwork gates_;
 };
 
@@ -0,0 +1,18 @@
+#pragma once
+#include <cmath>
+
+namespace universe {
+
+// Galactic position in light-years.
+struct Vec3 {
+    float x{0}, y{0}, z{0};
+};
+
+inline float distance_sq(const Vec3& a, const Vec3& b) {
+    float dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+inline float distance(const Vec3& a, const Vec3& b) { return std::sqrt(distance_sq(a, b)); }
+
+} // namespace universe
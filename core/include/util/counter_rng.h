@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace util {
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3").
+// A keyed bijection on 128-bit counters: the same (counter, key) always
+// yields the same block, so draws can be made in any order on any thread.
+inline std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key) {
+    constexpr uint32_t kM0 = 0xD2511F53u, kM1 = 0xCD9E8D57u;
+    constexpr uint32_t kW0 = 0x9E3779B9u, kW1 = 0xBB67AE85u;
+    for (int round = 0; round < 10; ++round) {
+        uint64_t p0 = static_cast<uint64_t>(kM0) * ctr[0];
+        uint64_t p1 = static_cast<uint64_t>(kM1) * ctr[2];
+        ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<uint32_t>(p1),
+               static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<uint32_t>(p0)};
+        key[0] += kW0;
+        key[1] += kW1;
+    }
+    return ctr;
+}
+
+// Sequence of draws addressed by (seed, stream, index): e.g. stream = "system
+// attributes", index = system number. Independent instances never share
+// state, so results do not depend on which thread makes them or in what order.
+class CounterRng {
+public:
+    CounterRng(uint64_t seed, uint32_t stream, uint64_t index)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          ctr_{static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32), stream, 0} {}
+
+    uint32_t next_u32() {
+        if (used_ == 4) {
+            block_ = philox4x32(ctr_, key_);
+            ++ctr_[3];
+            used_ = 0;
+        }
+        return block_[used_++];
+    }
+
+    uint64_t next_u64() {
+        uint64_t hi = next_u32();
+        return (hi << 32) | next_u32();
+    }
+
+    // Uniform in [0, n), n > 0 (Lemire's multiply-shift with rejection).
+    uint32_t uniform(uint32_t n) {
+        uint64_t m = static_cast<uint64_t>(next_u32()) * n;
+        auto low = static_cast<uint32_t>(m);
+        if (low < n) {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                m = static_cast<uint64_t>(next_u32()) * n;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Uniform in [lo, hi].
+    int32_t between(int32_t lo, int32_t hi) {
+        return lo + static_cast<int32_t>(uniform(static_cast<uint32_t>(hi - lo) + 1));
+    }
+
+    // Uniform in [0, 1) with 53 random bits.
+    double unit() { return static_cast<double>(next_u64() >> 11) * 0x1.0p-53; }
+
+private:
+    std::array<uint32_t, 2> key_;
+    std::array<uint32_t, 4> ctr_;
+    std::array<uint32_t, 4> block_{};
+    int used_ = 4;
+};
+
+} // namespace util
@@ -0,0 +1,44 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+// Worker count for a requested value (0 = hardware concurrency).
+inline unsigned worker_count(unsigned requested) {
+    if (requested > 0) return requested;
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// Runs fn(i) for every i in [0, count) on up to `threads` threads and blocks
+// until all are done. Indices are handed out in chunks of `grain`.
+template <class Fn>
+void parallel_for(size_t count, Fn&& fn, unsigned threads = 0, size_t grain = 1) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+
+    size_t chunks = (count + grain - 1) / grain;
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(worker_count(threads), chunks));
+
+    std::atomic<size_t> next{0};
+    auto run = [&] {
+        for (;;) {
+            size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count) return;
+            size_t end = std::min(count, begin + grain);
+            for (size_t i = begin; i < end; ++i) fn(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers > 0 ? workers - 1 : 0);
+    for (unsigned t = 1; t < workers; ++t) pool.emplace_back(run);
+    run();
+    for (auto& th : pool) th.join();
+}
+
+} // namespace util
@@ -0,0 +1,64 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+// Monotone priority queue for integer keys: every pushed key must be >= the
+// last popped key (true for Dijkstra and for A* with a consistent heuristic).
+// Keys are bucketed by the highest bit that differs from the last popped key,
+// so each element is moved at most ~64 times over its life.
+template <class V>
+class RadixHeap {
+public:
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void clear() {
+        for (auto& b : buckets_) b.clear();
+        size_ = 0;
+        last_ = 0;
+    }
+
+    void push(uint64_t key, V value) {
+        buckets_[bucket_of(key)].emplace_back(key, std::move(value));
+        ++size_;
+    }
+
+    // Removes and returns an element with the minimum key. Heap must be non-empty.
+    std::pair<uint64_t, V> pop() {
+        if (buckets_[0].empty()) {
+            size_t i = 1;
+            while (buckets_[i].empty()) ++i;
+
+            uint64_t min_key = std::numeric_limits<uint64_t>::max();
+            for (const auto& e : buckets_[i]) min_key = std::min(min_key, e.first);
+            last_ = min_key;
+
+            for (auto& e : buckets_[i]) buckets_[bucket_of(e.first)].push_back(std::move(e));
+            buckets_[i].clear();
+        }
+
+        auto top = std::move(buckets_[0].back());
+        buckets_[0].pop_back();
+        --size_;
+        return top;
+    }
+
+private:
+    std::array<std::vector<std::pair<uint64_t, V>>, 65> buckets_;
+    size_t size_ = 0;
+    uint64_t last_ = 0;
+
+    size_t bucket_of(uint64_t key) const {
+        return key == last_ ? 0 : static_cast<size_t>(64 - std::countl_zero(key ^ last_));
+    }
+};
+
+} // namespace util
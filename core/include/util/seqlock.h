@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace util {
+
+// Single-writer sequence lock over a small trivially copyable value.
+// Readers never block the writer and take no lock: they copy the value and
+// retry if a store overlapped the copy. The value is kept in atomic words,
+// so concurrent copies are not data races.
+template <class T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock needs a trivially copyable value");
+
+public:
+    SeqLock() { store(T{}); }
+    explicit SeqLock(const T& v) { store(v); }
+
+    // One writer at a time.
+    void store(const T& v) {
+        std::array<uint64_t, kWords> buf{};
+        std::memcpy(buf.data(), &v, sizeof(T));
+        const uint32_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        std::array<uint64_t, kWords> buf;
+        for (unsigned spins = 0;; ++spins) {
+            const uint32_t s0 = seq_.load(std::memory_order_acquire);
+            if ((s0 & 1) == 0) {
+                for (size_t i = 0; i < kWords; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == s0) break;
+            }
+            if (spins >= 64) std::this_thread::yield(); // writer preempted mid-store
+        }
+        T v;
+        std::memcpy(static_cast<void*>(&v), buf.data(), sizeof(T));
+        return v;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> seq_{0};
+    std::array<std::atomic<uint64_t>, kWords> words_{};
+};
+
+} // namespace util
@@ -0,0 +1,62 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util {
+
+// Persistent worker threads for repeated fork-join work (a simulation phase
+// every tick), so threads are not spawned per call as in parallel_for().
+// Each participant owns a deque of chunk tasks: it pops its own newest
+// chunk and, when empty, steals the oldest chunk of another participant,
+// so uneven chunks balance out without a shared queue.
+class WorkStealingPool {
+public:
+    // fn(begin, end, participant) over one chunk; participant < participants().
+    using ChunkFn = std::function<void(size_t, size_t, unsigned)>;
+
+    // threads = total participants including the calling thread
+    // (0 = hardware concurrency); threads - 1 workers are started.
+    explicit WorkStealingPool(unsigned threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned participants() const { return static_cast<unsigned>(queues_.size()); }
+
+    // Runs fn over [0, count) in chunks of `grain` and blocks until all are
+    // done; the caller works too. Chunk boundaries depend only on count and
+    // grain, never on the thread count. One run at a time per pool.
+    void run(size_t count, size_t grain, const ChunkFn& fn);
+
+private:
+    struct Job;
+    struct Task {
+        Job* job = nullptr;
+        size_t begin = 0, end = 0;
+    };
+    struct Queue {
+        std::mutex mu;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_; // [0] is the caller's
+    std::vector<std::thread> workers_;
+
+    std::mutex wake_mu_;
+    std::condition_variable wake_;
+    uint64_t generation_ = 0; // bumped per run; guarded by wake_mu_
+    bool stop_ = false;
+    std::mutex run_mu_;
+
+    bool try_run_one(unsigned self);
+    void worker_loop(unsigned self);
+};
+
+} // namespace util
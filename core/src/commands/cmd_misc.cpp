@@ -16,22 +16,17 @@ void register_misc_commands(Router& r, const universe::Universe& u) {
             return {false, "Usage: random_system", "usage", {}};
         }
 
-        const auto& systems = u.systems();
-        if (systems.empty()) {
+        if (u.system_count() == 0) {
             return {false, "Universe has no systems.", "empty_universe", {}};
         }
 
-        // Pick a random element from unordered_map
         static thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_int_distribution<size_t> dist(0, systems.size() - 1);
-
-        size_t idx = dist(rng);
-        auto it = systems.begin();
-        std::advance(it, static_cast<long>(idx));
+        std::uniform_int_distribution<uint32_t> dist(0, static_cast<uint32_t>(u.system_count() - 1));
 
+        uint32_t idx = dist(rng);
         std::ostringstream out;
-        out << "Random system: " << it->second.name << " (#" << it->second.id << ")\n";
-        out << "Tip: system " << it->second.name << "\n";
+        out << "Random system: " << u.name_at(idx) << " (#" << u.id_at(idx) << ")\n";
+        out << "Tip: system " << u.name_at(idx) << "\n";
         return {true, out.str(), "", {}};
     });
 
@@ -53,20 +48,12 @@ void register_misc_commands(Router& r, const universe::Universe& u) {
         if (count <= 0) return {false, "count must be >= 1.", "bad_count", {}};
         if (count > 20) count = 20; // keep output reasonable
 
-        const auto& systems = u.systems();
-        if (systems.size() < 2) {
+        if (u.system_count() < 2) {
             return {false, "Need at least 2 systems.", "empty_universe", {}};
         }
 
         static thread_local std::mt19937 rng(std::random_device{}());
-        std::uniform_int_distribution<size_t> dist(0, systems.size() - 1);
-
-        auto pick_name = [&]() -> std::string {
-            size_t idx = dist(rng);
-            auto it = systems.begin();
-            std::advance(it, static_cast<long>(idx));
-            return it->second.name;
-        };
+        std::uniform_int_distribution<uint32_t> dist(0, static_cast<uint32_t>(u.system_count() - 1));
 
         std::ostringstream out;
         out << "Random routes:\n";
@@ -75,18 +62,14 @@ void register_misc_commands(Router& r, const universe::Universe& u) {
         int tries = 0;
         while (made < count && tries < count * 10) {
             ++tries;
-            std::string a = pick_name();
-            std::string b = pick_name();
+            uint32_t a = dist(rng);
+            uint32_t b = dist(rng);
             if (a == b) continue;
 
-            auto ida = u.find_system_by_name(a);
-            auto idb = u.find_system_by_name(b);
-            if (!ida || !idb) continue;
-
-            auto rr = u.gates().shortest_route(*ida, *idb);
+            auto rr = u.gates().shortest_route(u.id_at(a), u.id_at(b));
             if (!rr) continue;
 
-            out << "  - " << a << " -> " << b << " : " << rr->jumps << " jumps\n";
+            out << "  - " << u.name_at(a) << " -> " << u.name_at(b) << " : " << rr->jumps << " jumps\n";
             ++made;
         }
 
@@ -1,14 +1,31 @@
 #include "commands/cmd_universe.h"
+#include "universe/gate_analytics.h"
+#include "universe/route_planner.h"
+#include "universe/system_contents.h"
+#include <algorithm>
+#include <memory>
 #include <sstream>
 
 namespace commands {
 
-static std::string sys_name(const universe::Universe& u, universe::SystemId id) {
-    auto s = u.get_system(id);
-    return s ? s->name : ("#" + std::to_string(id));
+// Streams a system's name straight from the universe's name arena ("#id"
+// if unknown), so formatting routes and listings allocates nothing per system.
+struct SysName {
+    const universe::Universe& u;
+    universe::SystemId id;
+};
+
+static std::ostream& operator<<(std::ostream& os, const SysName& n) {
+    std::string_view name = n.u.name_of(n.id);
+    if (name.empty()) return os << '#' << n.id;
+    return os << name;
+}
+
+static SysName sys_name(const universe::Universe& u, universe::SystemId id) {
+    return {u, id};
 }
 
-void register_universe_commands(Router& r, const universe::Universe& u) {
+void register_universe_commands(Router& r, const universe::Universe& u, const universe::SimStateStore* sim) {
 
     r.add("gates", [&u](const Context&, const Command& cmd) -> Result {
         if (cmd.args.size() != 1) {
@@ -25,6 +42,26 @@ void register_universe_commands(Router& r, const universe::Universe& u) {
         return {true, out.str(), "", {}};
     });
 
+    // find <prefix>[*]: systems whose name starts with prefix (case-insensitive).
+    r.add("find", [&u](const Context&, const Command& cmd) -> Result {
+        if (cmd.args.size() != 1) {
+            return {false, "Usage: find <prefix>[*]", "usage", {}};
+        }
+        std::string_view prefix = cmd.args[0];
+        if (!prefix.empty() && prefix.back() == '*') prefix.remove_suffix(1);
+        if (prefix.empty()) return {false, "Prefix must not be empty.", "usage", {}};
+
+        constexpr size_t kShow = 20;
+        auto ids = u.find_systems_by_prefix(prefix, kShow + 1);
+        if (ids.empty()) return {false, "No systems match: " + cmd.args[0], "unknown_system", {}};
+
+        std::ostringstream out;
+        out << "Systems matching " << cmd.args[0] << ":\n";
+        for (size_t i = 0; i < ids.size() && i < kShow; ++i) out << "  - " << sys_name(u, ids[i]) << "\n";
+        if (ids.size() > kShow) out << "  ...\n";
+        return {true, out.str(), "", {}};
+    });
+
     r.add("route", [&u](const Context&, const Command& cmd) -> Result {
         if (cmd.args.size() != 2) {
             return {false, "Usage: route <from> <to>", "usage", {}};
@@ -47,6 +84,163 @@ void register_universe_commands(Router& r, const universe::Universe& u) {
         return {true, out.str(), "", {}};
     });
 
+    // route_avoid <from> <to> <system>...: shortest route with the listed
+    // systems closed, via a per-query overlay.
+    r.add("route_avoid", [&u](const Context&, const Command& cmd) -> Result {
+        if (cmd.args.size() < 3) {
+            return {false, "Usage: route_avoid <from> <to> <system>...", "usage", {}};
+        }
+        auto a = u.find_system_by_name(cmd.args[0]);
+        auto b = u.find_system_by_name(cmd.args[1]);
+        if (!a) return {false, "Unknown system: " + cmd.args[0], "unknown_system", {}};
+        if (!b) return {false, "Unknown system: " + cmd.args[1], "unknown_system", {}};
+
+        universe::GateOverlay avoid(u.gates());
+        for (size_t i = 2; i < cmd.args.size(); ++i) {
+            auto sid = u.find_system_by_name(cmd.args[i]);
+            if (!sid) return {false, "Unknown system: " + cmd.args[i], "unknown_system", {}};
+            avoid.close_system(u.gates(), *sid);
+        }
+
+        auto rr = u.gates().shortest_route(*a, *b, &avoid);
+        if (!rr) return {false, "No route found.", "no_route", {}};
+
+        std::ostringstream out;
+        out << "Route: " << cmd.args[0] << " -> " << cmd.args[1] << " (avoiding " << (cmd.args.size() - 2) << ")\n";
+        out << "Jumps: " << rr->jumps << "\n";
+        out << "Path:\n";
+        for (size_t i = 0; i < rr->path.size(); ++i) {
+            out << "  " << (i + 1) << ") " << sys_name(u, rr->path[i]) << "\n";
+        }
+        return {true, out.str(), "", {}};
+    });
+
+    // routes <from> <to> <k>: up to k loopless alternatives, shortest first.
+    r.add("routes", [&u](const Context&, const Command& cmd) -> Result {
+        if (cmd.args.size() != 3) {
+            return {false, "Usage: routes <from> <to> <k>", "usage", {}};
+        }
+        auto a = u.find_system_by_name(cmd.args[0]);
+        auto b = u.find_system_by_name(cmd.args[1]);
+        if (!a) return {false, "Unknown system: " + cmd.args[0], "unknown_system", {}};
+        if (!b) return {false, "Unknown system: " + cmd.args[1], "unknown_system", {}};
+
+        int k = 0;
+        try { k = std::stoi(cmd.args[2]); }
+        catch (...) { return {false, "k must be a number.", "bad_number", {}}; }
+        if (k <= 0) return {false, "k must be >= 1.", "bad_number", {}};
+        if (k > 10) k = 10; // keep output reasonable
+
+        auto routes = u.gates().k_shortest_routes(*a, *b, k);
+        if (routes.empty()) return {false, "No route found.", "no_route", {}};
+
+        std::ostringstream out;
+        out << "Routes: " << cmd.args[0] << " -> " << cmd.args[1] << "\n";
+        for (size_t i = 0; i < routes.size(); ++i) {
+            out << "  " << (i + 1) << ") " << routes[i].jumps << " jumps:";
+            for (size_t j = 0; j < routes[i].path.size(); ++j) {
+                out << (j == 0 ? " " : " -> ") << sys_name(u, routes[i].path[j]);
+            }
+            out << "\n";
+        }
+        return {true, out.str(), "", {}};
+    });
+
+    // Weighted route that prefers high-security space and never passes
+    // through lawless systems. Costs are snapshotted at registration.
+    universe::RouteCostProfile safe;
+    safe.avoid_lawless = true;
+    auto planner = std::make_shared<universe::RoutePlanner>(u, safe);
+
+    r.add("safe_route", [&u, planner](const Context&, const Command& cmd) -> Result {
+        if (cmd.args.size() != 2) {
+            return {false, "Usage: safe_route <from> <to>", "usage", {}};
+        }
+        auto a = u.find_system_by_name(cmd.args[0]);
+        auto b = u.find_system_by_name(cmd.args[1]);
+        if (!a) return {false, "Unknown system: " + cmd.args[0], "unknown_system", {}};
+        if (!b) return {false, "Unknown system: " + cmd.args[1], "unknown_system", {}};
+
+        auto wr = planner->route(*a, *b);
+        if (!wr) return {false, "No safe route found.", "no_route", {}};
+
+        std::ostringstream out;
+        out << "Safe route: " << cmd.args[0] << " -> " << cmd.args[1] << "\n";
+        out << "Jumps: " << wr->jumps << "\n";
+        out << "Cost: " << wr->cost << "\n";
+        out << "Path:\n";
+        for (size_t i = 0; i < wr->path.size(); ++i) {
+            out << "  " << (i + 1) << ") " << sys_name(u, wr->path[i]) << "\n";
+        }
+        return {true, out.str(), "", {}};
+    });
+
+    // Chokepoint analytics, computed on first use and cached until the gate
+    // topology changes.
+    auto analytics = std::make_shared<universe::GateAnalytics>(u.gates());
+
+    r.add("chokepoints", [&u, analytics](const Context&, const Command& cmd) -> Result {
+        if (!cmd.args.empty()) {
+            return {false, "Usage: chokepoints", "usage", {}};
+        }
+        auto rep = analytics->chokepoints();
+        constexpr size_t kShow = 20;
+
+        std::ostringstream out;
+        out << "Chokepoint systems: " << rep->articulation_points.size() << "\n";
+        for (size_t i = 0; i < rep->articulation_points.size() && i < kShow; ++i) {
+            out << "  - " << sys_name(u, rep->articulation_points[i]) << "\n";
+        }
+        if (rep->articulation_points.size() > kShow) out << "  ...\n";
+
+        out << "Bridge gates: " << rep->bridges.size() << "\n";
+        for (size_t i = 0; i < rep->bridges.size() && i < kShow; ++i) {
+            out << "  - " << sys_name(u, rep->bridges[i].first) << " <-> "
+                << sys_name(u, rep->bridges[i].second) << "\n";
+        }
+        if (rep->bridges.size() > kShow) out << "  ...\n";
+        return {true, out.str(), "", {}};
+    });
+
+    r.add("hubs", [&u, analytics](const Context&, const Command& cmd) -> Result {
+        if (cmd.args.size() > 1) {
+            return {false, "Usage: hubs [N]", "usage", {}};
+        }
+        int n = 10;
+        if (cmd.args.size() == 1) {
+            try { n = std::stoi(cmd.args[0]); }
+            catch (...) { return {false, "N must be a number.", "bad_number", {}}; }
+            if (n <= 0) return {false, "N must be >= 1.", "bad_number", {}};
+            if (n > 50) n = 50; // keep output reasonable
+        }
+
+        auto bc = analytics->betweenness();
+        const auto& g = u.gates();
+
+        std::vector<universe::NodeIndex> order(bc->size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<universe::NodeIndex>(i);
+        size_t top = std::min(order.size(), static_cast<size_t>(n));
+        std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(top), order.end(),
+                          [&](universe::NodeIndex a, universe::NodeIndex b) {
+                              double da = (*bc)[static_cast<size_t>(a)], db = (*bc)[static_cast<size_t>(b)];
+                              return da != db ? da > db : g.id_at(a) < g.id_at(b);
+                          });
+
+        // Share of all system pairs whose shortest routes pass through the hub.
+        double nodes = static_cast<double>(bc->size());
+        double pairs = nodes > 2 ? (nodes - 1) * (nodes - 2) / 2 : 1.0;
+
+        std::ostringstream out;
+        out << "Top " << top << " hubs by betweenness:\n";
+        out.setf(std::ios::fixed);
+        out.precision(4);
+        for (size_t i = 0; i < top; ++i) {
+            out << "  " << (i + 1) << ") " << sys_name(u, g.id_at(order[i])) << "  "
+                << (*bc)[static_cast<size_t>(order[i])] / pairs << "\n";
+        }
+        return {true, out.str(), "", {}};
+    });
+
     r.add("nearby", [&u](const Context&, const Command& cmd) -> Result {
         if (cmd.args.size() != 2) {
             return {false, "Usage: nearby <system> <N>", "usage", {}};
@@ -66,7 +260,97 @@ void register_universe_commands(Router& r, const universe::Universe& u) {
         return {true, out.str(), "", {}};
     });
 
-    r.add("system", [&u](const Context&, const Command& cmd) -> Result {
+    // ftl <system> <ly>: systems reachable by FTL within a straight-line
+    // range, nearest first (spatial index, no gates involved).
+    r.add("ftl", [&u](const Context&, const Command& cmd) -> Result {
+        if (cmd.args.size() != 2) {
+            return {false, "Usage: ftl <system> <ly>", "usage", {}};
+        }
+        auto sid = u.find_system_by_name(cmd.args[0]);
+        if (!sid) return {false, "Unknown system: " + cmd.args[0], "unknown_system", {}};
+
+        double ly = 0;
+        try { ly = std::stod(cmd.args[1]); }
+        catch (...) { return {false, "Range must be a number.", "bad_number", {}}; }
+        if (!(ly > 0)) return {false, "Range must be > 0.", "bad_number", {}};
+
+        auto sys = u.view(*sid);
+        if (!sys) return {false, "System missing (internal error).", "internal", {}};
+        auto hits = u.systems_within_ly(sys->position, static_cast<float>(ly));
+        constexpr size_t kShow = 20;
+
+        std::ostringstream out;
+        out.setf(std::ios::fixed);
+        out.precision(1);
+        auto others = std::count_if(hits.begin(), hits.end(), [&](const auto& h) { return h.id != *sid; });
+        out << "Systems within " << ly << " ly of " << cmd.args[0] << ": " << others << "\n";
+        size_t shown = 0;
+        for (const auto& h : hits) {
+            if (h.id == *sid) continue;
+            if (shown++ == kShow) {
+                out << "  ...\n";
+                break;
+            }
+            out << "  - " << sys_name(u, h.id) << "  " << h.ly << " ly\n";
+        }
+        return {true, out.str(), "", {}};
+    });
+
+    // System contents are generated from the seed when first looked at and
+    // kept in an LRU cache; evicted systems are simply regenerated.
+    auto contents = std::make_shared<universe::SystemContentsCache>(u);
+
+    r.add("bodies", [&u, contents](const Context&, const Command& cmd) -> Result {
+        if (cmd.args.size() != 1) {
+            return {false, "Usage: bodies <system>", "usage", {}};
+        }
+        auto sid = u.find_system_by_name(cmd.args[0]);
+        if (!sid) return {false, "Unknown system: " + cmd.args[0], "unknown_system", {}};
+
+        auto c = contents->get(*sid);
+        if (!c) return {false, "System missing (internal error).", "internal", {}};
+
+        auto class_to_str = [](universe::BodyClass k) {
+            switch (k) {
+                case universe::BodyClass::None: return "";
+                case universe::BodyClass::Lava: return "lava";
+                case universe::BodyClass::Rocky: return "rocky";
+                case universe::BodyClass::Desert: return "desert";
+                case universe::BodyClass::Ocean: return "ocean";
+                case universe::BodyClass::Ice: return "ice";
+                case universe::BodyClass::GasGiant: return "gas giant";
+            }
+            return "unknown";
+        };
+
+        std::ostringstream out;
+        out << "Bodies of " << cmd.args[0] << ": " << c->bodies.size() << "\n";
+        out.setf(std::ios::fixed);
+        out.precision(2);
+        int planet = 0, belt = 0, moon = 0;
+        for (const auto& b : c->bodies) {
+            switch (b.type) {
+                case universe::BodyType::Planet:
+                    out << "  " << sys_name(u, *sid) << ' ' << ++planet << "  " << class_to_str(b.body_class)
+                        << " planet  " << b.orbit_au << " AU";
+                    moon = 0;
+                    break;
+                case universe::BodyType::Moon:
+                    out << "    moon " << planet << '-' << static_cast<char>('a' + moon++) << "  "
+                        << class_to_str(b.body_class);
+                    break;
+                case universe::BodyType::AsteroidBelt:
+                    out << "  Belt " << ++belt << "  asteroid belt  " << b.orbit_au << " AU";
+                    break;
+            }
+            out << "  richness " << int(b.richness);
+            if (b.owner_faction_id != 0) out << "  owner " << b.owner_faction_id;
+            out << "\n";
+        }
+        return {true, out.str(), "", {}};
+    });
+
+    r.add("system", [&u, sim](const Context&, const Command& cmd) -> Result {
         if (cmd.args.size() != 1) {
             return {false, "Usage: system <system>", "usage", {}};
         }
@@ -74,7 +358,7 @@ void register_universe_commands(Router& r, const universe::Universe& u) {
         auto sid = u.find_system_by_name(cmd.args[0]);
         if (!sid) return {false, "Unknown system: " + cmd.args[0], "unknown_system", {}};
 
-        auto sys = u.get_system(*sid);
+        auto sys = u.view(*sid);
         if (!sys) return {false, "System missing (internal error).", "internal", {}};
 
         auto type_to_str = [](universe::SystemType t) {
@@ -100,7 +384,19 @@ void register_universe_commands(Router& r, const universe::Universe& u) {
         out << "System: " << sys->name << " (#" << sys->id << ")\n";
         out << "Type: " << type_to_str(sys->type) << "\n";
         out << "Security: " << sec_to_str(sys->security) << "\n";
-        out << "OwnerFaction: " << sys->owner_faction_id << "\n";
+        if (sim) {
+            auto state = sim->read();
+            auto i = *u.dense_index(*sid);
+            out << "OwnerFaction: " << state->owners[i] << "\n";
+            out << "Stock: " << state->stock[i] << "\n";
+            out << "Fleets: " << state->fleets[i] << "\n";
+            out << "AsOfTick: " << state->tick << "\n";
+        } else {
+            out << "OwnerFaction: " << sys->owner_faction_id << "\n";
+        }
+        out.setf(std::ios::fixed);
+        out.precision(1);
+        out << "Position: " << sys->position.x << ", " << sys->position.y << ", " << sys->position.z << " ly\n";
         out << "Gates:\n";
         for (auto n : u.gates().neighbors(*sid)) {
             out << "  - " << sys_name(u, n) << "\n";
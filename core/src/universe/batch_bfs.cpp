@@ -0,0 +1,150 @@
+#include "universe/batch_bfs.h"
+#include "universe/gate_network.h"
+#include "util/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+namespace universe {
+
+namespace {
+
+struct LaneSet {
+    uint64_t w[kBatchWords];
+};
+
+// One bit-parallel BFS for up to kBatchLanes sources. Lane j starts at
+// batch[j]; visit(lane, node, level) fires once per newly reached pair and
+// returns false to stop after the current level. Returns true if the sweep
+// ran out of frontier, false if it was cut short by max_level or visit.
+template <class Visit>
+bool sweep(const GateNetwork& g, std::span<const NodeIndex> batch, int max_level, Visit&& visit) {
+    static thread_local std::vector<LaneSet> visited, frontier, next;
+
+    const size_t n = static_cast<size_t>(g.node_count());
+    visited.assign(n, LaneSet{});
+    frontier.assign(n, LaneSet{});
+    next.resize(n);
+
+    LaneSet used{};
+    bool keep_going = true;
+    for (size_t j = 0; j < batch.size(); ++j) {
+        const uint64_t bit = uint64_t{1} << (j % 64);
+        const size_t word = j / 64;
+        used.w[word] |= bit;
+        visited[static_cast<size_t>(batch[j])].w[word] |= bit;
+        frontier[static_cast<size_t>(batch[j])].w[word] |= bit;
+        keep_going &= visit(static_cast<int>(j), batch[j], 0);
+    }
+
+    for (int level = 1; keep_going; ++level) {
+        if (level > max_level) return false;
+
+        bool any = false;
+        for (size_t v = 0; v < n; ++v) {
+            LaneSet& seen = visited[v];
+            LaneSet acc{};
+
+            bool full = true;
+            for (int w = 0; w < kBatchWords; ++w) full &= (seen.w[w] & used.w[w]) == used.w[w];
+            if (!full) {
+                for (NodeIndex u : g.dense_neighbors(static_cast<NodeIndex>(v))) {
+                    const LaneSet& f = frontier[static_cast<size_t>(u)];
+                    for (int w = 0; w < kBatchWords; ++w) acc.w[w] |= f.w[w];
+                }
+                for (int w = 0; w < kBatchWords; ++w) acc.w[w] &= ~seen.w[w];
+            }
+
+            next[v] = acc;
+            for (int w = 0; w < kBatchWords; ++w) {
+                uint64_t bits = acc.w[w];
+                if (!bits) continue;
+                any = true;
+                seen.w[w] |= bits;
+                while (bits) {
+                    int lane = w * 64 + std::countr_zero(bits);
+                    bits &= bits - 1;
+                    keep_going &= visit(lane, static_cast<NodeIndex>(v), level);
+                }
+            }
+        }
+
+        if (!any) return true;
+        frontier.swap(next);
+    }
+    return false;
+}
+
+size_t batch_count(size_t sources) {
+    return (sources + kBatchLanes - 1) / kBatchLanes;
+}
+
+} // namespace
+
+JumpMatrix batch_jump_distances(const GateNetwork& g,
+                                std::span<const NodeIndex> sources,
+                                std::span<const NodeIndex> targets,
+                                unsigned threads) {
+    JumpMatrix m;
+    m.rows = static_cast<int>(sources.size());
+    m.cols = static_cast<int>(targets.size());
+    m.jumps.assign(sources.size() * targets.size(), -1);
+    if (!g.frozen() || sources.empty() || targets.empty()) return m;
+
+    // Target columns grouped per node (CSR), so duplicate targets just work.
+    const size_t n = static_cast<size_t>(g.node_count());
+    std::vector<int32_t> col_off(n + 1, 0);
+    for (NodeIndex t : targets) col_off[static_cast<size_t>(t) + 1]++;
+    for (size_t i = 0; i < n; ++i) col_off[i + 1] += col_off[i];
+    std::vector<int32_t> cols(targets.size());
+    {
+        std::vector<int32_t> fill(col_off.begin(), col_off.end() - 1);
+        for (size_t c = 0; c < targets.size(); ++c) {
+            cols[static_cast<size_t>(fill[static_cast<size_t>(targets[c])]++)] = static_cast<int32_t>(c);
+        }
+    }
+
+    util::parallel_for(batch_count(sources.size()), [&](size_t b) {
+        const size_t base = b * kBatchLanes;
+        auto batch = sources.subspan(base, std::min<size_t>(kBatchLanes, sources.size() - base));
+
+        size_t remaining = batch.size() * targets.size();
+        sweep(g, batch, INT32_MAX, [&](int lane, NodeIndex v, int level) {
+            int32_t* row = m.jumps.data() + (base + static_cast<size_t>(lane)) * targets.size();
+            for (int32_t k = col_off[static_cast<size_t>(v)]; k < col_off[static_cast<size_t>(v) + 1]; ++k) {
+                row[cols[static_cast<size_t>(k)]] = level;
+                --remaining;
+            }
+            return remaining > 0;
+        });
+    }, threads);
+
+    return m;
+}
+
+bool batch_all_pairs_u8(const GateNetwork& g, uint8_t* out, unsigned threads) {
+    if (!g.frozen()) return false;
+
+    const size_t n = static_cast<size_t>(g.node_count());
+    std::vector<NodeIndex> all(n);
+    for (size_t i = 0; i < n; ++i) all[i] = static_cast<NodeIndex>(i);
+
+    std::atomic<bool> overflow{false};
+    util::parallel_for(batch_count(n), [&](size_t b) {
+        const size_t base = b * kBatchLanes;
+        auto batch = std::span<const NodeIndex>(all).subspan(base, std::min<size_t>(kBatchLanes, n - base));
+
+        std::memset(out + base * n, 0xFF, batch.size() * n);
+        bool complete = sweep(g, batch, 0xFE, [&](int lane, NodeIndex v, int level) {
+            out[(base + static_cast<size_t>(lane)) * n + static_cast<size_t>(v)] = static_cast<uint8_t>(level);
+            return true;
+        });
+        if (!complete) overflow.store(true, std::memory_order_relaxed);
+    }, threads);
+
+    return !overflow.load();
+}
+
+} // namespace universe
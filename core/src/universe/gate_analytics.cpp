@@ -0,0 +1,183 @@
+#include "universe/gate_analytics.h"
+#include "util/parallel.h"
+
+#include <algorithm>
+
+namespace universe {
+
+namespace {
+
+// Betweenness source blocks: enough to balance a few threads, few enough
+// that the per-block accumulators (n doubles each) stay small.
+constexpr size_t kBetweennessBlocks = 16;
+
+} // namespace
+
+ChokepointReport find_chokepoints(const GateNetwork& g) {
+    ChokepointReport rep;
+    if (!g.frozen()) return rep;
+
+    const size_t n = static_cast<size_t>(g.node_count());
+    std::vector<int32_t> disc(n, -1), low(n, 0);
+    std::vector<uint8_t> cut(n, 0);
+
+    struct Frame {
+        NodeIndex node;
+        EdgeIndex via; // gate we arrived through, -1 at the root
+        size_t slot;   // next neighbor to look at
+    };
+    std::vector<Frame> stack;
+    int32_t timer = 0;
+
+    for (NodeIndex root = 0; root < static_cast<NodeIndex>(n); ++root) {
+        if (disc[static_cast<size_t>(root)] != -1) continue;
+
+        int root_children = 0;
+        disc[static_cast<size_t>(root)] = low[static_cast<size_t>(root)] = timer++;
+        stack.push_back({root, -1, 0});
+
+        while (!stack.empty()) {
+            Frame& f = stack.back();
+            auto u = static_cast<size_t>(f.node);
+            auto nbrs = g.dense_neighbors(f.node);
+
+            if (f.slot < nbrs.size()) {
+                NodeIndex v = nbrs[f.slot];
+                EdgeIndex e = g.dense_edges(f.node)[f.slot];
+                ++f.slot;
+                if (e == f.via) continue;
+                if (disc[static_cast<size_t>(v)] == -1) {
+                    disc[static_cast<size_t>(v)] = low[static_cast<size_t>(v)] = timer++;
+                    stack.push_back({v, e, 0}); // f is invalidated here
+                } else {
+                    low[u] = std::min(low[u], disc[static_cast<size_t>(v)]);
+                }
+                continue;
+            }
+
+            // u is finished: fold its low-link into the parent.
+            stack.pop_back();
+            if (stack.empty()) break;
+            auto p = static_cast<size_t>(stack.back().node);
+            low[p] = std::min(low[p], low[u]);
+
+            if (low[u] > disc[p]) {
+                SystemId a = g.id_at(static_cast<NodeIndex>(p)), b = g.id_at(static_cast<NodeIndex>(u));
+                rep.bridges.emplace_back(std::min(a, b), std::max(a, b));
+            }
+            if (static_cast<NodeIndex>(p) == root) ++root_children;
+            else if (low[u] >= disc[p]) cut[p] = 1;
+        }
+        if (root_children >= 2) cut[static_cast<size_t>(root)] = 1;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (cut[i]) rep.articulation_points.push_back(g.id_at(static_cast<NodeIndex>(i)));
+    }
+    std::sort(rep.articulation_points.begin(), rep.articulation_points.end());
+    std::sort(rep.bridges.begin(), rep.bridges.end());
+    return rep;
+}
+
+std::vector<double> betweenness_centrality(const GateNetwork& g, unsigned threads) {
+    const size_t n = static_cast<size_t>(g.node_count());
+    std::vector<double> result(n, 0.0);
+    if (!g.frozen() || n < 3) return result;
+
+    // Sources are split into a fixed number of contiguous blocks, each with
+    // its own accumulator, and the blocks are summed in block order. Neither
+    // depends on the thread count or scheduling, so the floating-point sums
+    // (and ties between equally central systems) are the same on every run.
+    const size_t blocks = std::min(kBetweennessBlocks, n);
+    std::vector<std::vector<double>> acc(blocks);
+
+    util::parallel_for(blocks, [&](size_t b) {
+        std::vector<double>& mine = acc[b];
+        mine.assign(n, 0.0);
+
+        std::vector<int32_t> dist(n, -1);
+        std::vector<double> sigma(n, 0.0), delta(n, 0.0);
+        std::vector<NodeIndex> order;
+        order.reserve(n);
+
+        for (size_t s = b * n / blocks; s < (b + 1) * n / blocks; ++s) {
+            // Forward BFS counting shortest paths; `order` doubles as the queue.
+            order.clear();
+            order.push_back(static_cast<NodeIndex>(s));
+            dist[s] = 0;
+            sigma[s] = 1.0;
+            for (size_t head = 0; head < order.size(); ++head) {
+                NodeIndex v = order[head];
+                int32_t dv = dist[static_cast<size_t>(v)];
+                for (NodeIndex w2 : g.dense_neighbors(v)) {
+                    auto wi = static_cast<size_t>(w2);
+                    if (dist[wi] < 0) {
+                        dist[wi] = dv + 1;
+                        order.push_back(w2);
+                    }
+                    if (dist[wi] == dv + 1) sigma[wi] += sigma[static_cast<size_t>(v)];
+                }
+            }
+
+            // Dependency accumulation in reverse BFS order, walking successors
+            // instead of stored predecessor lists.
+            for (size_t k = order.size(); k-- > 0;) {
+                auto v = static_cast<size_t>(order[k]);
+                double dep = 0.0;
+                for (NodeIndex w2 : g.dense_neighbors(order[k])) {
+                    auto wi = static_cast<size_t>(w2);
+                    if (dist[wi] == dist[v] + 1) dep += sigma[v] / sigma[wi] * (1.0 + delta[wi]);
+                }
+                delta[v] = dep;
+                if (v != s) mine[v] += dep;
+            }
+
+            for (NodeIndex v : order) {
+                auto vi = static_cast<size_t>(v);
+                dist[vi] = -1;
+                sigma[vi] = 0.0;
+                delta[vi] = 0.0;
+            }
+        }
+    }, threads);
+
+    // Every unordered pair was counted from both ends.
+    for (const auto& a : acc) {
+        for (size_t i = 0; i < n; ++i) result[i] += a[i];
+    }
+    for (double& r : result) r *= 0.5;
+    return result;
+}
+
+template <class T, class Fn>
+std::shared_ptr<const T> GateAnalytics::cached(Cache<T>& cache, Fn&& compute) const {
+    const uint64_t v = g_->topology_version();
+    std::promise<std::shared_ptr<const T>> mine;
+    std::shared_future<std::shared_ptr<const T>> result;
+    {
+        std::lock_guard<std::mutex> lock(cache.mu);
+        if (cache.result.valid() && cache.version == v) {
+            result = cache.result;
+        } else {
+            cache.result = mine.get_future().share();
+            cache.version = v;
+        }
+    }
+    if (result.valid()) return result.get();
+
+    auto value = std::make_shared<const T>(compute());
+    mine.set_value(value);
+    return value;
+}
+
+std::shared_ptr<const ChokepointReport> GateAnalytics::chokepoints() const {
+    if (!g_->frozen()) return std::make_shared<const ChokepointReport>();
+    return cached(chokepoints_, [&] { return find_chokepoints(*g_); });
+}
+
+std::shared_ptr<const std::vector<double>> GateAnalytics::betweenness() const {
+    if (!g_->frozen()) return std::make_shared<const std::vector<double>>(g_->node_count(), 0.0);
+    return cached(betweenness_, [&] { return betweenness_centrality(*g_, threads_); });
+}
+
+} // namespace universe
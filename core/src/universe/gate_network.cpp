@@ -1,138 +1,489 @@
 #include "universe/gate_network.h"
-#include <queue>
+#include "universe/search_workspace.h"
 #include <algorithm>
+#include <set>
 
 namespace universe {
 
-static std::vector<SystemId> kEmpty;
+std::optional<NodeIndex> GateNetwork::index_of(SystemId id) const {
+    if (contiguous_) {
+        if (ids_.empty()) return std::nullopt;
+        int64_t i = static_cast<int64_t>(id) - ids_.front();
+        if (i < 0 || i >= static_cast<int64_t>(ids_.size())) return std::nullopt;
+        return static_cast<NodeIndex>(i);
+    }
+    auto it = index_.find(id);
+    if (it == index_.end()) return std::nullopt;
+    return it->second;
+}
+
+template <class Fn>
+void GateNetwork::for_each_neighbor(NodeIndex i, Fn&& fn) const {
+    if (frozen_) {
+        for (NodeIndex n : dense_neighbors(i)) fn(n);
+        return;
+    }
+    for (SystemId n : adj_[static_cast<size_t>(i)]) fn(*index_of(n));
+}
 
-const std::vector<SystemId>& GateNetwork::empty_neighbors() { return kEmpty; }
+template <class Fn>
+void GateNetwork::for_each_open_neighbor(NodeIndex i, const GateOverlay* overlay, Fn&& fn) const {
+    if (!overlay) {
+        for_each_neighbor(i, fn);
+        return;
+    }
+    auto nbrs = dense_neighbors(i);
+    auto edges = dense_edges(i);
+    for (size_t k = 0; k < nbrs.size(); ++k) {
+        if (overlay->edge_enabled(edges[k]) && overlay->node_enabled(nbrs[k])) fn(nbrs[k]);
+    }
+}
+
+EdgeIndex GateNetwork::edge_between(NodeIndex a, NodeIndex b) const {
+    auto nbrs = dense_neighbors(a);
+    for (size_t k = 0; k < nbrs.size(); ++k) {
+        if (nbrs[k] == b) return dense_edges(a)[k];
+    }
+    return -1;
+}
 
-GateNetwork::Edge GateNetwork::norm(SystemId a, SystemId b) {
-    return (a < b) ? Edge{a, b} : Edge{b, a};
+std::optional<EdgeIndex> GateNetwork::edge_index(SystemId a, SystemId b) const {
+    auto ia = index_of(a);
+    auto ib = index_of(b);
+    if (!frozen_ || !ia || !ib) return std::nullopt;
+    EdgeIndex e = edge_between(*ia, *ib);
+    if (e < 0) return std::nullopt;
+    return e;
 }
 
 void GateNetwork::add_node(SystemId id) {
-    adj_.try_emplace(id, std::vector<SystemId>{});
+    if (has_node(id)) return;
+    bool was_frozen = frozen_;
+    if (was_frozen) thaw();
+
+    NodeIndex idx = node_count();
+    if (contiguous_ && !ids_.empty() && id != ids_.front() + idx) {
+        // Run broken: fall back to the hash map from here on.
+        index_.reserve(ids_.size() + 1);
+        for (NodeIndex i = 0; i < idx; ++i) index_.emplace(ids_[static_cast<size_t>(i)], i);
+        contiguous_ = false;
+    }
+    if (!contiguous_) index_.emplace(id, idx);
+
+    ids_.push_back(id);
+    adj_.emplace_back();
+    adj_edges_.emplace_back();
+
+    uf_parent_.push_back(idx);
+    uf_rank_.push_back(0);
+    components_++;
+    topology_version_++;
+
+    if (was_frozen) compile();
 }
 
 bool GateNetwork::has_node(SystemId id) const {
-    return adj_.contains(id);
+    return index_of(id).has_value();
 }
 
 bool GateNetwork::add_gate(SystemId a, SystemId b) {
     if (a == b) return false;
+    if (has_gate(a, b)) return false;
+
+    bool was_frozen = frozen_;
+    if (was_frozen) thaw();
+
     add_node(a);
     add_node(b);
 
-    Edge e = norm(a, b);
-    if (edges_.contains(e)) return false;
-
-    edges_.insert(e);
-    adj_[a].push_back(b);
-    adj_[b].push_back(a);
+    NodeIndex ia = *index_of(a);
+    NodeIndex ib = *index_of(b);
+    adj_[static_cast<size_t>(ia)].push_back(b);
+    adj_[static_cast<size_t>(ib)].push_back(a);
+    adj_edges_[static_cast<size_t>(ia)].push_back(gate_count_);
+    adj_edges_[static_cast<size_t>(ib)].push_back(gate_count_);
     gate_count_++;
+    topology_version_++;
+
+    uf_union(ia, ib);
+
+    if (was_frozen) compile();
     return true;
 }
 
 bool GateNetwork::has_gate(SystemId a, SystemId b) const {
     if (a == b) return false;
-    return edges_.contains(norm(a, b));
+    auto ia = index_of(a);
+    auto ib = index_of(b);
+    if (!ia || !ib) return false;
+
+    // Scan the shorter list; gate degrees are small.
+    auto na = neighbors(a);
+    auto nb = neighbors(b);
+    if (nb.size() < na.size()) return std::find(nb.begin(), nb.end(), a) != nb.end();
+    return std::find(na.begin(), na.end(), b) != na.end();
 }
 
-const std::vector<SystemId>& GateNetwork::neighbors(SystemId id) const {
-    auto it = adj_.find(id);
-    return (it == adj_.end()) ? empty_neighbors() : it->second;
+std::span<const SystemId> GateNetwork::neighbors(SystemId id) const {
+    auto i = index_of(id);
+    if (!i) return {};
+    if (frozen_) {
+        return {target_ids_.data() + offsets_[*i], target_ids_.data() + offsets_[*i + 1]};
+    }
+    return adj_[static_cast<size_t>(*i)];
 }
 
-std::optional<RouteResult> GateNetwork::shortest_route(SystemId start, SystemId goal) const {
-    if (!has_node(start) || !has_node(goal)) return std::nullopt;
-    if (start == goal) return RouteResult{0, {start}};
+void GateNetwork::freeze(const FreezeOptions& opts) {
+    freeze_opts_ = opts;
+    if (!frozen_) compile();
+    build_indexes();
+}
+
+void GateNetwork::compile() {
+    const size_t n = ids_.size();
+    offsets_.assign(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        offsets_[i + 1] = offsets_[i] + static_cast<int32_t>(adj_[i].size());
+    }
 
-    std::queue<SystemId> q;
-    std::unordered_map<SystemId, SystemId> prev;
-    std::unordered_map<SystemId, int> dist;
+    targets_.resize(static_cast<size_t>(offsets_[n]));
+    target_ids_.resize(static_cast<size_t>(offsets_[n]));
+    edge_ids_.resize(static_cast<size_t>(offsets_[n]));
+    for (size_t i = 0; i < n; ++i) {
+        size_t k = static_cast<size_t>(offsets_[i]);
+        for (size_t j = 0; j < adj_[i].size(); ++j, ++k) {
+            target_ids_[k] = adj_[i][j];
+            targets_[k] = *index_of(adj_[i][j]);
+            edge_ids_[k] = adj_edges_[i][j];
+        }
+    }
 
-    q.push(start);
-    dist[start] = 0;
+    for (NodeIndex i = 0; i < static_cast<NodeIndex>(n); ++i) uf_find(i);
 
-    while (!q.empty()) {
-        SystemId cur = q.front();
-        q.pop();
+    adj_.clear();
+    adj_.shrink_to_fit();
+    adj_edges_.clear();
+    adj_edges_.shrink_to_fit();
+    frozen_ = true;
+}
+
+void GateNetwork::build_indexes() {
+    route_table_.clear();
+    region_index_.clear();
+    if (freeze_opts_.route_table && node_count() <= freeze_opts_.route_table_max_nodes) {
+        route_table_.build(*this, freeze_opts_.threads);
+    }
+    if (route_table_.empty() && freeze_opts_.region_index && node_count() >= freeze_opts_.region_index_min_nodes) {
+        region_index_.build(*this, freeze_opts_.region_size, freeze_opts_.threads);
+    }
+}
 
-        for (SystemId nxt : neighbors(cur)) {
-            if (dist.contains(nxt)) continue;
+void GateNetwork::thaw() {
+    if (!frozen_) return;
 
-            dist[nxt] = dist[cur] + 1;
-            prev[nxt] = cur;
+    const size_t n = ids_.size();
+    adj_.assign(n, {});
+    adj_edges_.assign(n, {});
+    for (size_t i = 0; i < n; ++i) {
+        adj_[i].assign(target_ids_.begin() + offsets_[i], target_ids_.begin() + offsets_[i + 1]);
+        adj_edges_[i].assign(edge_ids_.begin() + offsets_[i], edge_ids_.begin() + offsets_[i + 1]);
+    }
 
-            if (nxt == goal) {
-                std::vector<SystemId> path;
-                for (SystemId p = goal;; p = prev[p]) {
-                    path.push_back(p);
-                    if (p == start) break;
-                }
-                std::reverse(path.begin(), path.end());
-                return RouteResult{dist[goal], std::move(path)};
-            }
+    offsets_.clear();
+    targets_.clear();
+    target_ids_.clear();
+    edge_ids_.clear();
+    route_table_.clear();
+    region_index_.clear();
+    frozen_ = false;
+}
 
-            q.push(nxt);
+std::optional<RouteResult> GateNetwork::shortest_route(SystemId start, SystemId goal,
+                                                       const GateOverlay* overlay) const {
+    auto s = index_of(start);
+    auto g = index_of(goal);
+    if (!s || !g || (overlay && !frozen_)) return std::nullopt;
+    if (start == goal) return RouteResult{0, {start}};
+    if (uf_root(*s) != uf_root(*g)) return std::nullopt;
+
+    const RouteTable* rt = overlay ? nullptr : route_table();
+    if (rt) {
+        uint8_t d = rt->distance(*s, *g);
+        if (d == RouteTable::kUnreachable) return std::nullopt;
+
+        RouteResult rr{d, {}};
+        rr.path.reserve(static_cast<size_t>(d) + 1);
+        rr.path.push_back(start);
+        for (NodeIndex cur = *s; cur != *g;) {
+            cur = dense_neighbors(cur)[rt->next_slot(cur, *g)];
+            rr.path.push_back(id_at(cur));
         }
+        return rr;
     }
 
-    return std::nullopt;
+    std::vector<NodeIndex> path;
+    const RegionIndex* ri = overlay ? nullptr : region_index();
+    if (ri) {
+        if (!ri->shortest_path(*this, *s, *g, path)) return std::nullopt;
+        return to_route(path);
+    }
+    if (!bidirectional_path(*s, *g, overlay, path)) return std::nullopt;
+    return to_route(path);
 }
 
-std::vector<SystemId> GateNetwork::within(SystemId start, int max_jumps, bool include_start) const {
-    std::vector<SystemId> out;
-    if (!has_node(start) || max_jumps < 0) return out;
+RouteResult GateNetwork::to_route(std::span<const NodeIndex> path) const {
+    RouteResult rr{static_cast<int>(path.size()) - 1, {}};
+    rr.path.reserve(path.size());
+    for (NodeIndex p : path) rr.path.push_back(id_at(p));
+    return rr;
+}
 
-    std::queue<SystemId> q;
-    std::unordered_map<SystemId, int> dist;
+bool GateNetwork::bidirectional_path(NodeIndex s, NodeIndex g, const GateOverlay* overlay,
+                                     std::vector<NodeIndex>& path) const {
+    // Side 0 grows from the start, side 1 from the goal. Each round expands one
+    // full BFS level of the smaller frontier; the best meeting found in that
+    // level is a shortest route.
+    path.clear();
+    if (s == g) {
+        path.push_back(s);
+        return true;
+    }
+    if (overlay && !overlay->node_enabled(g)) return false;
+
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(ids_.size());
+
+    ws.visit(s, 0, -1, 0);
+    ws.visit(g, 0, -1, 1);
+    ws.queue(0).push_back(s);
+    ws.queue(1).push_back(g);
+    size_t head[SearchWorkspace::kSides] = {0, 0};
+
+    int best = -1;
+    NodeIndex meet_fwd = -1;
+    NodeIndex meet_bwd = -1;
+
+    while (head[0] < ws.queue(0).size() && head[1] < ws.queue(1).size()) {
+        const int side = (ws.queue(0).size() - head[0] <= ws.queue(1).size() - head[1]) ? 0 : 1;
+        const int other = 1 - side;
+        auto& q = ws.queue(side);
+
+        for (size_t level_end = q.size(); head[side] < level_end; ++head[side]) {
+            NodeIndex cur = q[head[side]];
+            int32_t d = ws.dist(cur, side);
+
+            for_each_open_neighbor(cur, overlay, [&](NodeIndex nxt) {
+                if (ws.seen(nxt, other)) {
+                    int total = d + 1 + ws.dist(nxt, other);
+                    if (best < 0 || total < best) {
+                        best = total;
+                        meet_fwd = side == 0 ? cur : nxt;
+                        meet_bwd = side == 0 ? nxt : cur;
+                    }
+                }
+                if (ws.seen(nxt, side)) return;
+                ws.visit(nxt, d + 1, cur, side);
+                q.push_back(nxt);
+            });
+        }
+
+        if (best >= 0) break;
+    }
 
-    q.push(start);
-    dist[start] = 0;
+    if (best < 0) return false;
 
-    while (!q.empty()) {
-        SystemId cur = q.front();
-        q.pop();
+    path.reserve(static_cast<size_t>(best) + 1);
+    for (NodeIndex p = meet_fwd; p != -1; p = ws.parent(p, 0)) path.push_back(p);
+    std::reverse(path.begin(), path.end());
+    for (NodeIndex p = meet_bwd; p != -1; p = ws.parent(p, 1)) path.push_back(p);
+    return true;
+}
 
-        int d = dist[cur];
-        if (d > max_jumps) continue;
+std::vector<RouteResult> GateNetwork::k_shortest_routes(SystemId start, SystemId goal, int k,
+                                                        const GateOverlay* overlay) const {
+    std::vector<RouteResult> out;
+    auto s = index_of(start);
+    auto g = index_of(goal);
+    if (!s || !g || k <= 0 || !frozen_) return out;
+
+    std::vector<std::vector<NodeIndex>> accepted(1);
+    if (!bidirectional_path(*s, *g, overlay, accepted[0])) return out;
+
+    // Candidates ordered by jumps, then path, so ties resolve deterministically.
+    std::set<std::pair<size_t, std::vector<NodeIndex>>> candidates;
+    std::set<std::vector<NodeIndex>> known{accepted[0]};
+
+    // Spur mask starts as a copy of the caller's overlay (two small bitsets).
+    GateOverlay mask = overlay ? *overlay : GateOverlay(*this);
+    std::vector<EdgeIndex> cut;
+    std::vector<NodeIndex> closed;
+    std::vector<NodeIndex> spur_path;
+
+    while (static_cast<int>(accepted.size()) < k) {
+        const std::vector<NodeIndex>& prev = accepted.back();
+
+        for (size_t i = 0; i + 1 < prev.size(); ++i) {
+            // Deviate at prev[i]: close the next gate of every accepted route
+            // sharing this root, and keep the search off the root itself.
+            cut.clear();
+            for (const auto& p : accepted) {
+                if (p.size() > i + 1 && std::equal(prev.begin(), prev.begin() + static_cast<long>(i) + 1, p.begin())) {
+                    EdgeIndex e = edge_between(p[i], p[i + 1]);
+                    if (!mask.edge_enabled(e)) continue;
+                    mask.disable_edge(e);
+                    cut.push_back(e);
+                }
+            }
+            closed.clear();
+            for (size_t j = 0; j < i; ++j) {
+                if (!mask.node_enabled(prev[j])) continue;
+                mask.disable_node(prev[j]);
+                closed.push_back(prev[j]);
+            }
 
-        if (include_start || cur != start) out.push_back(cur);
+            if (bidirectional_path(prev[i], *g, &mask, spur_path)) {
+                std::vector<NodeIndex> total(prev.begin(), prev.begin() + static_cast<long>(i));
+                total.insert(total.end(), spur_path.begin(), spur_path.end());
+                if (known.insert(total).second) candidates.emplace(total.size(), std::move(total));
+            }
 
-        for (SystemId nxt : neighbors(cur)) {
-            if (dist.contains(nxt)) continue;
-            dist[nxt] = d + 1;
-            if (dist[nxt] <= max_jumps) q.push(nxt);
+            // Undo only what this spur touched.
+            for (EdgeIndex e : cut) mask.enable_edge(e);
+            for (NodeIndex v : closed) mask.enable_node(v);
         }
+
+        if (candidates.empty()) break;
+        auto best = candidates.begin();
+        accepted.push_back(best->second);
+        candidates.erase(best);
     }
 
+    out.reserve(accepted.size());
+    for (const auto& p : accepted) out.push_back(to_route(p));
     return out;
 }
 
-bool GateNetwork::is_connected() const {
-    if (adj_.empty()) return true;
+std::vector<SystemId> GateNetwork::within(SystemId start, int max_jumps, bool include_start,
+                                          const GateOverlay* overlay) const {
+    std::vector<SystemId> out;
+    auto s = index_of(start);
+    if (!s || max_jumps < 0 || (overlay && !frozen_)) return out;
+
+    // Always a BFS, even with a route table: it only touches the ball,
+    // while a table row costs O(N) however small the radius.
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(ids_.size());
+    auto& q = ws.queue();
+
+    q.push_back(*s);
+    ws.visit(*s, 0, -1);
+
+    for (size_t head = 0; head < q.size(); ++head) {
+        NodeIndex cur = q[head];
+        int32_t d = ws.dist(cur);
+
+        if (include_start || cur != *s) out.push_back(id_at(cur));
+        if (d == max_jumps) continue;
+
+        for_each_open_neighbor(cur, overlay, [&](NodeIndex nxt) {
+            if (ws.seen(nxt)) return;
+            ws.visit(nxt, d + 1, cur);
+            q.push_back(nxt);
+        });
+    }
+
+    return out;
+}
 
-    SystemId start = adj_.begin()->first;
-    std::queue<SystemId> q;
-    std::unordered_set<SystemId> seen;
+JumpMatrix GateNetwork::jump_distances(std::span<const SystemId> sources,
+                                       std::span<const SystemId> targets) const {
+    // Unknown ids keep their row/column at -1.
+    std::vector<NodeIndex> src, dst;
+    std::vector<int> src_row, dst_col;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (auto idx = index_of(sources[i])) { src.push_back(*idx); src_row.push_back(static_cast<int>(i)); }
+    }
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (auto idx = index_of(targets[i])) { dst.push_back(*idx); dst_col.push_back(static_cast<int>(i)); }
+    }
 
-    q.push(start);
-    seen.insert(start);
+    JumpMatrix dense = batch_jump_distances(*this, src, dst, freeze_opts_.threads);
+    if (src.size() == sources.size() && dst.size() == targets.size()) return dense;
 
-    while (!q.empty()) {
-        SystemId cur = q.front();
-        q.pop();
-        for (SystemId nxt : neighbors(cur)) {
-            if (seen.contains(nxt)) continue;
-            seen.insert(nxt);
-            q.push(nxt);
+    JumpMatrix m;
+    m.rows = static_cast<int>(sources.size());
+    m.cols = static_cast<int>(targets.size());
+    m.jumps.assign(sources.size() * targets.size(), -1);
+    for (int r = 0; r < dense.rows; ++r) {
+        for (int c = 0; c < dense.cols; ++c) {
+            m.jumps[static_cast<size_t>(src_row[r]) * targets.size() + static_cast<size_t>(dst_col[c])] = dense.at(r, c);
         }
     }
+    return m;
+}
+
+std::vector<SystemId> GateNetwork::within_any(std::span<const SystemId> sources, int max_jumps) const {
+    std::vector<SystemId> out;
+    if (max_jumps < 0) return out;
+
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(ids_.size());
+    auto& q = ws.queue();
+
+    for (SystemId id : sources) {
+        auto i = index_of(id);
+        if (!i || ws.seen(*i)) continue;
+        ws.visit(*i, 0, -1);
+        q.push_back(*i);
+    }
+
+    for (size_t head = 0; head < q.size(); ++head) {
+        NodeIndex cur = q[head];
+        int32_t d = ws.dist(cur);
+
+        out.push_back(id_at(cur));
+        if (d == max_jumps) continue;
+
+        for_each_neighbor(cur, [&](NodeIndex nxt) {
+            if (ws.seen(nxt)) return;
+            ws.visit(nxt, d + 1, cur);
+            q.push_back(nxt);
+        });
+    }
+
+    return out;
+}
+
+std::optional<SystemId> GateNetwork::component_of(SystemId id) const {
+    auto i = index_of(id);
+    if (!i) return std::nullopt;
+    return id_at(uf_root(*i));
+}
+
+NodeIndex GateNetwork::uf_find(NodeIndex i) {
+    NodeIndex root = uf_root(i);
+    while (uf_parent_[static_cast<size_t>(i)] != root) {
+        NodeIndex next = uf_parent_[static_cast<size_t>(i)];
+        uf_parent_[static_cast<size_t>(i)] = root;
+        i = next;
+    }
+    return root;
+}
+
+void GateNetwork::uf_union(NodeIndex a, NodeIndex b) {
+    NodeIndex ra = uf_find(a);
+    NodeIndex rb = uf_find(b);
+    if (ra == rb) return;
+    if (uf_rank_[static_cast<size_t>(ra)] < uf_rank_[static_cast<size_t>(rb)]) std::swap(ra, rb);
+    uf_parent_[static_cast<size_t>(rb)] = ra;
+    if (uf_rank_[static_cast<size_t>(ra)] == uf_rank_[static_cast<size_t>(rb)]) uf_rank_[static_cast<size_t>(ra)]++;
+    components_--;
+}
 
-    return seen.size() == adj_.size();
+NodeIndex GateNetwork::uf_root(NodeIndex i) const {
+    // No writes here so concurrent readers stay safe.
+    while (uf_parent_[static_cast<size_t>(i)] != i) i = uf_parent_[static_cast<size_t>(i)];
+    return i;
 }
 
 } // namespace universe
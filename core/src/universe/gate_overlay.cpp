@@ -0,0 +1,45 @@
+#include "universe/gate_overlay.h"
+#include "universe/gate_network.h"
+
+#include <algorithm>
+
+namespace universe {
+
+GateOverlay::GateOverlay(const GateNetwork& g)
+    : nodes_((static_cast<size_t>(g.node_count()) + 63) / 64, 0),
+      edges_((static_cast<size_t>(g.gate_count()) + 63) / 64, 0) {}
+
+bool GateOverlay::close_system(const GateNetwork& g, SystemId id) {
+    auto i = g.index_of(id);
+    if (!i) return false;
+    disable_node(*i);
+    return true;
+}
+
+bool GateOverlay::open_system(const GateNetwork& g, SystemId id) {
+    auto i = g.index_of(id);
+    if (!i) return false;
+    enable_node(*i);
+    return true;
+}
+
+bool GateOverlay::close_gate(const GateNetwork& g, SystemId a, SystemId b) {
+    auto e = g.edge_index(a, b);
+    if (!e) return false;
+    disable_edge(*e);
+    return true;
+}
+
+bool GateOverlay::open_gate(const GateNetwork& g, SystemId a, SystemId b) {
+    auto e = g.edge_index(a, b);
+    if (!e) return false;
+    enable_edge(*e);
+    return true;
+}
+
+void GateOverlay::clear() {
+    std::fill(nodes_.begin(), nodes_.end(), 0);
+    std::fill(edges_.begin(), edges_.end(), 0);
+}
+
+} // namespace universe
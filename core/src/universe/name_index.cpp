@@ -0,0 +1,104 @@
+#include "universe/name_index.h"
+
+#include <algorithm>
+
+namespace universe {
+
+namespace {
+
+// Folded three-way compare of a stored (already folded) key against a query.
+int compare_folded(std::string_view stored, std::string_view query) {
+    size_t n = std::min(stored.size(), query.size());
+    for (size_t i = 0; i < n; ++i) {
+        char q = NameIndex::fold(query[i]);
+        if (stored[i] != q) return static_cast<unsigned char>(stored[i]) < static_cast<unsigned char>(q) ? -1 : 1;
+    }
+    if (stored.size() == query.size()) return 0;
+    return stored.size() < query.size() ? -1 : 1;
+}
+
+} // namespace
+
+uint64_t NameIndex::hash(std::string_view name) {
+    // FNV-1a over folded bytes.
+    uint64_t h = 1469598103934665603ull;
+    for (char c : name) {
+        h ^= static_cast<unsigned char>(fold(c));
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+size_t NameIndex::memory_bytes() const {
+    return folded_.capacity() + (offsets_.capacity() + slots_.capacity() + sorted_.capacity()) * sizeof(uint32_t) +
+           ids_.capacity() * sizeof(SystemId);
+}
+
+std::optional<uint32_t> NameIndex::lookup(std::string_view name) const {
+    if (slots_.empty()) return std::nullopt;
+    const size_t mask = slots_.size() - 1;
+    for (size_t i = hash(name) & mask;; i = (i + 1) & mask) {
+        uint32_t s = slots_[i];
+        if (s == 0) return std::nullopt;
+        if (compare_folded(key(s - 1), name) == 0) return s - 1;
+    }
+}
+
+void NameIndex::grow() {
+    // Keep the table at most half full.
+    size_t cap = std::max<size_t>(16, slots_.size() * 2);
+    slots_.assign(cap, 0);
+    for (uint32_t e = 0; e < ids_.size(); ++e) {
+        size_t i = hash(key(e)) & (cap - 1);
+        while (slots_[i] != 0) i = (i + 1) & (cap - 1);
+        slots_[i] = e + 1;
+    }
+}
+
+bool NameIndex::add(std::string_view name, SystemId id) {
+    if (lookup(name)) return false;
+
+    const auto e = static_cast<uint32_t>(ids_.size());
+    for (char c : name) folded_.push_back(fold(c));
+    offsets_.push_back(static_cast<uint32_t>(folded_.size()));
+    ids_.push_back(id);
+
+    if (ids_.size() * 2 > slots_.size()) {
+        grow();
+    } else {
+        size_t mask = slots_.size() - 1;
+        size_t i = hash(name) & mask;
+        while (slots_[i] != 0) i = (i + 1) & mask;
+        slots_[i] = e + 1;
+    }
+
+    // Generated names arrive in order, so this is usually an append.
+    std::string_view k = key(e);
+    auto it = sorted_.empty() || key(sorted_.back()) < k
+                  ? sorted_.end()
+                  : std::lower_bound(sorted_.begin(), sorted_.end(), k,
+                                     [&](uint32_t a, std::string_view b) { return key(a) < b; });
+    sorted_.insert(it, e);
+    return true;
+}
+
+std::optional<SystemId> NameIndex::find(std::string_view name) const {
+    auto e = lookup(name);
+    if (!e) return std::nullopt;
+    return ids_[*e];
+}
+
+std::vector<SystemId> NameIndex::find_prefix(std::string_view prefix, size_t limit) const {
+    auto it = std::lower_bound(sorted_.begin(), sorted_.end(), prefix,
+                               [&](uint32_t a, std::string_view p) { return compare_folded(key(a), p) < 0; });
+
+    std::vector<SystemId> out;
+    for (; it != sorted_.end() && out.size() < limit; ++it) {
+        std::string_view k = key(*it);
+        if (k.size() < prefix.size() || compare_folded(k.substr(0, prefix.size()), prefix) != 0) break;
+        out.push_back(ids_[*it]);
+    }
+    return out;
+}
+
+} // namespace universe
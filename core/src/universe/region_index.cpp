@@ -0,0 +1,474 @@
+#include "universe/region_index.h"
+#include "universe/gate_network.h"
+#include "universe/search_workspace.h"
+#include "util/parallel.h"
+#include "util/radix_heap.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace universe {
+
+namespace {
+
+// Overlay edges allowed per system before the index gives up. Graphs with
+// no locality make nearly every system a border and the cliques explode.
+constexpr size_t kEdgeBudgetPerNode = 64;
+
+constexpr int kLandmarks = 8;
+
+// Below this estimated diameter, bidirectional BFS meets after a handful of
+// levels and beats any overlay search; the index isn't worth building.
+constexpr int kMinDiameter = 48;
+
+constexpr uint16_t kFar = 0xFFFF;
+
+// Jump distances from `from` (kFar if unreachable, saturating below it).
+void bfs_distances(const GateNetwork& g, NodeIndex from, std::vector<uint16_t>& out) {
+    out.assign(static_cast<size_t>(g.node_count()), kFar);
+    std::vector<NodeIndex> q{from};
+    out[static_cast<size_t>(from)] = 0;
+    for (size_t head = 0; head < q.size(); ++head) {
+        uint16_t d = out[static_cast<size_t>(q[head])];
+        for (NodeIndex nxt : g.dense_neighbors(q[head])) {
+            if (out[static_cast<size_t>(nxt)] != kFar) continue;
+            out[static_cast<size_t>(nxt)] = static_cast<uint16_t>(std::min<int>(d + 1, kFar - 1));
+            q.push_back(nxt);
+        }
+    }
+}
+
+// Reachable node with the largest distance.
+NodeIndex farthest(const std::vector<uint16_t>& dist) {
+    size_t best = 0;
+    for (size_t v = 0; v < dist.size(); ++v) {
+        if (dist[v] != kFar && (dist[best] == kFar || dist[v] > dist[best])) best = v;
+    }
+    return static_cast<NodeIndex>(best);
+}
+
+// Some node of the largest connected component.
+NodeIndex largest_component_node(const GateNetwork& g) {
+    std::unordered_map<SystemId, int> sizes;
+    SystemId largest = *g.component_of(g.id_at(0));
+    for (NodeIndex i = 0; i < g.node_count(); ++i) {
+        SystemId c = *g.component_of(g.id_at(i));
+        if (++sizes[c] > sizes[largest]) largest = c;
+    }
+    NodeIndex i = 0;
+    while (*g.component_of(g.id_at(i)) != largest) ++i;
+    return i;
+}
+
+struct OverlayEdge {
+    int32_t from;
+    int32_t to;
+    uint16_t w;
+};
+
+// All nodes in breadth-first order, component by component. Seeding regions
+// in this order makes each new region start on the previous ones' frontier.
+std::vector<NodeIndex> bfs_order(const GateNetwork& g) {
+    const size_t n = static_cast<size_t>(g.node_count());
+    std::vector<NodeIndex> order;
+    order.reserve(n);
+    std::vector<uint8_t> seen(n, 0);
+    for (NodeIndex root = 0; root < static_cast<NodeIndex>(n); ++root) {
+        if (seen[static_cast<size_t>(root)]) continue;
+        seen[static_cast<size_t>(root)] = 1;
+        size_t head = order.size();
+        order.push_back(root);
+        for (; head < order.size(); ++head) {
+            for (NodeIndex nxt : g.dense_neighbors(order[head])) {
+                if (seen[static_cast<size_t>(nxt)]) continue;
+                seen[static_cast<size_t>(nxt)] = 1;
+                order.push_back(nxt);
+            }
+        }
+    }
+    return order;
+}
+
+} // namespace
+
+void RegionIndex::clear() {
+    regions_ = 0;
+    landmarks_ = 0;
+    landmark_dist_.clear();
+    landmark_dist_.shrink_to_fit();
+    for (auto* v : {&region_, &overlay_id_, &border_nodes_, &offsets_, &targets_}) {
+        v->clear();
+        v->shrink_to_fit();
+    }
+    weights_.clear();
+    weights_.shrink_to_fit();
+}
+
+size_t RegionIndex::memory_bytes() const {
+    return (region_.size() + overlay_id_.size() + border_nodes_.size() + offsets_.size() + targets_.size()) *
+               sizeof(int32_t) +
+           (weights_.size() + landmark_dist_.size()) * sizeof(uint16_t);
+}
+
+void RegionIndex::region_bfs(const GateNetwork& g, NodeIndex from, int side, NodeIndex stop) const {
+    SearchWorkspace& ws = SearchWorkspace::local();
+    const int32_t r = region_of(from);
+    auto& q = ws.queue(side);
+    q.clear();
+
+    ws.visit(from, 0, -1, side);
+    q.push_back(from);
+    for (size_t head = 0; head < q.size(); ++head) {
+        NodeIndex cur = q[head];
+        if (cur == stop) return;
+        int32_t d = ws.dist(cur, side);
+        for (NodeIndex nxt : g.dense_neighbors(cur)) {
+            if (region_of(nxt) != r || ws.seen(nxt, side)) continue;
+            ws.visit(nxt, d + 1, cur, side);
+            q.push_back(nxt);
+        }
+    }
+}
+
+void RegionIndex::merge_fragments(const GateNetwork& g, std::vector<int32_t>& sizes, int region_size) {
+    const size_t n = region_.size();
+
+    // Members of each region, grouped (counting sort).
+    std::vector<int32_t> start(static_cast<size_t>(regions_) + 1, 0);
+    for (int32_t r : region_) start[static_cast<size_t>(r) + 1]++;
+    for (size_t r = 0; r < static_cast<size_t>(regions_); ++r) start[r + 1] += start[r];
+    std::vector<NodeIndex> members(n);
+    {
+        std::vector<int32_t> fill(start.begin(), start.end() - 1);
+        for (NodeIndex i = 0; i < static_cast<NodeIndex>(n); ++i) {
+            members[static_cast<size_t>(fill[static_cast<size_t>(region_[static_cast<size_t>(i)])]++)] = i;
+        }
+    }
+
+    std::vector<int32_t> merged_into(static_cast<size_t>(regions_));
+    for (int32_t r = 0; r < regions_; ++r) merged_into[static_cast<size_t>(r)] = r;
+    auto root = [&](int32_t r) {
+        while (merged_into[static_cast<size_t>(r)] != r) {
+            r = merged_into[static_cast<size_t>(r)] = merged_into[static_cast<size_t>(merged_into[static_cast<size_t>(r)])];
+        }
+        return r;
+    };
+
+    std::vector<int32_t> order(static_cast<size_t>(regions_));
+    for (int32_t r = 0; r < regions_; ++r) order[static_cast<size_t>(r)] = r;
+    std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+        return sizes[static_cast<size_t>(a)] < sizes[static_cast<size_t>(b)];
+    });
+
+    std::vector<int32_t> shared(static_cast<size_t>(regions_), 0);
+    std::vector<int32_t> touched;
+    for (int32_t r : order) {
+        if (sizes[static_cast<size_t>(r)] * 2 >= region_size) break;
+        const int32_t self = root(r);
+
+        // Gates from this fragment's own members to each neighboring region.
+        touched.clear();
+        for (int32_t k = start[static_cast<size_t>(r)]; k < start[static_cast<size_t>(r) + 1]; ++k) {
+            for (NodeIndex nxt : g.dense_neighbors(members[static_cast<size_t>(k)])) {
+                int32_t o = root(region_[static_cast<size_t>(nxt)]);
+                if (o == self) continue;
+                if (shared[static_cast<size_t>(o)]++ == 0) touched.push_back(o);
+            }
+        }
+
+        int32_t best = -1;
+        for (int32_t o : touched) {
+            if (sizes[static_cast<size_t>(o)] + sizes[static_cast<size_t>(self)] <= region_size &&
+                (best < 0 || shared[static_cast<size_t>(o)] > shared[static_cast<size_t>(best)])) {
+                best = o;
+            }
+        }
+        for (int32_t o : touched) shared[static_cast<size_t>(o)] = 0;
+        if (best < 0) continue;
+
+        merged_into[static_cast<size_t>(self)] = best;
+        sizes[static_cast<size_t>(best)] += sizes[static_cast<size_t>(self)];
+    }
+
+    // Compact the surviving region ids.
+    std::vector<int32_t> label(static_cast<size_t>(regions_), -1);
+    int32_t count = 0;
+    for (int32_t r = 0; r < regions_; ++r) {
+        if (root(r) == r) label[static_cast<size_t>(r)] = count++;
+    }
+    for (auto& r : region_) r = label[static_cast<size_t>(root(r))];
+    regions_ = count;
+}
+
+bool RegionIndex::build(const GateNetwork& g, int region_size, unsigned threads) {
+    clear();
+    if (!g.frozen() || g.node_count() == 0) return false;
+
+    const size_t n = static_cast<size_t>(g.node_count());
+    region_size = std::clamp(region_size, 1, static_cast<int>(std::numeric_limits<uint16_t>::max()));
+
+    // Double-sweep BFS over the largest component: a cheap diameter estimate.
+    const NodeIndex start = largest_component_node(g);
+    std::vector<uint16_t> sweep;
+    bfs_distances(g, start, sweep);
+    bfs_distances(g, farthest(sweep), sweep);
+    if (sweep[static_cast<size_t>(farthest(sweep))] < kMinDiameter) return false;
+
+    // Partition: grow each region breadth-first from the lowest unassigned
+    // system until it is full, then fold leftover fragments into the
+    // neighbor they share the most gates with. Linear time, and BFS balls
+    // keep borders small on graphs with any spatial locality.
+    region_.assign(n, -1);
+    std::vector<NodeIndex> seeds = bfs_order(g);
+    std::vector<int32_t> sizes;
+    std::vector<NodeIndex> queue;
+    queue.reserve(static_cast<size_t>(region_size));
+    for (NodeIndex seed : seeds) {
+        if (region_[static_cast<size_t>(seed)] != -1) continue;
+        const int32_t r = regions_++;
+        queue.clear();
+        queue.push_back(seed);
+        region_[static_cast<size_t>(seed)] = r;
+        for (size_t head = 0; head < queue.size() && queue.size() < static_cast<size_t>(region_size); ++head) {
+            for (NodeIndex nxt : g.dense_neighbors(queue[head])) {
+                if (region_[static_cast<size_t>(nxt)] != -1) continue;
+                region_[static_cast<size_t>(nxt)] = r;
+                queue.push_back(nxt);
+                if (queue.size() == static_cast<size_t>(region_size)) break;
+            }
+        }
+        sizes.push_back(static_cast<int32_t>(queue.size()));
+    }
+    merge_fragments(g, sizes, region_size);
+
+    // Borders, grouped by region.
+    overlay_id_.assign(n, -1);
+    std::vector<int32_t> region_start(static_cast<size_t>(regions_) + 1, 0);
+    for (NodeIndex i = 0; i < static_cast<NodeIndex>(n); ++i) {
+        for (NodeIndex nxt : g.dense_neighbors(i)) {
+            if (region_of(nxt) != region_of(i)) {
+                overlay_id_[static_cast<size_t>(i)] = 0;
+                region_start[static_cast<size_t>(region_of(i)) + 1]++;
+                break;
+            }
+        }
+    }
+    for (size_t r = 0; r < static_cast<size_t>(regions_); ++r) region_start[r + 1] += region_start[r];
+
+    size_t clique_edges = 0;
+    for (size_t r = 0; r < static_cast<size_t>(regions_); ++r) {
+        size_t b = static_cast<size_t>(region_start[r + 1] - region_start[r]);
+        clique_edges += b * (b - (b > 0));
+    }
+    if (clique_edges > kEdgeBudgetPerNode * n) {
+        clear();
+        return false;
+    }
+
+    border_nodes_.resize(static_cast<size_t>(region_start.back()));
+    {
+        std::vector<int32_t> fill(region_start.begin(), region_start.end() - 1);
+        for (NodeIndex i = 0; i < static_cast<NodeIndex>(n); ++i) {
+            if (overlay_id_[static_cast<size_t>(i)] < 0) continue;
+            int32_t o = fill[static_cast<size_t>(region_of(i))]++;
+            overlay_id_[static_cast<size_t>(i)] = o;
+            border_nodes_[static_cast<size_t>(o)] = i;
+        }
+    }
+
+    // Border cliques: one in-region BFS per border, regions in parallel.
+    std::vector<std::vector<OverlayEdge>> per_region(static_cast<size_t>(regions_));
+    util::parallel_for(static_cast<size_t>(regions_), [&](size_t r) {
+        SearchWorkspace& ws = SearchWorkspace::local();
+        auto& out = per_region[r];
+        for (int32_t a = region_start[r]; a < region_start[r + 1]; ++a) {
+            ws.begin(n);
+            region_bfs(g, border_nodes_[static_cast<size_t>(a)], 0);
+            for (int32_t b = region_start[r]; b < region_start[r + 1]; ++b) {
+                NodeIndex nb = border_nodes_[static_cast<size_t>(b)];
+                if (b == a || !ws.seen(nb)) continue;
+                out.push_back({a, b, static_cast<uint16_t>(ws.dist(nb))});
+            }
+        }
+    }, threads);
+
+    // Assemble the overlay CSR: clique edges plus one edge per cross-region gate.
+    const size_t borders = border_nodes_.size();
+    offsets_.assign(borders + 1, 0);
+    for (const auto& edges : per_region) {
+        for (const auto& e : edges) offsets_[static_cast<size_t>(e.from) + 1]++;
+    }
+    for (size_t o = 0; o < borders; ++o) {
+        NodeIndex i = border_nodes_[o];
+        for (NodeIndex nxt : g.dense_neighbors(i)) {
+            if (region_of(nxt) != region_of(i)) offsets_[o + 1]++;
+        }
+    }
+    for (size_t o = 0; o < borders; ++o) offsets_[o + 1] += offsets_[o];
+
+    targets_.resize(static_cast<size_t>(offsets_.back()));
+    weights_.resize(targets_.size());
+    std::vector<int32_t> fill(offsets_.begin(), offsets_.end() - 1);
+    for (auto& edges : per_region) {
+        for (const auto& e : edges) {
+            int32_t k = fill[static_cast<size_t>(e.from)]++;
+            targets_[static_cast<size_t>(k)] = e.to;
+            weights_[static_cast<size_t>(k)] = e.w;
+        }
+        edges = {};
+    }
+    for (size_t o = 0; o < borders; ++o) {
+        NodeIndex i = border_nodes_[o];
+        for (NodeIndex nxt : g.dense_neighbors(i)) {
+            if (region_of(nxt) == region_of(i)) continue;
+            int32_t k = fill[o]++;
+            targets_[static_cast<size_t>(k)] = overlay_id_[static_cast<size_t>(nxt)];
+            weights_[static_cast<size_t>(k)] = 1;
+        }
+    }
+
+    build_landmarks(g, start, kLandmarks);
+    return true;
+}
+
+void RegionIndex::build_landmarks(const GateNetwork& g, NodeIndex start, int count) {
+    const size_t n = static_cast<size_t>(g.node_count());
+
+    // Landmarks only help queries in their own component, so spend them all
+    // on the largest one (farthest-point selection within it).
+    std::vector<uint16_t> closest, d;
+    bfs_distances(g, start, closest);
+    std::vector<std::vector<uint16_t>> rows;
+    for (int k = 0; k < count; ++k) {
+        NodeIndex pick = farthest(closest);
+        if (closest[static_cast<size_t>(pick)] == 0) break;
+        bfs_distances(g, pick, d);
+        for (size_t v = 0; v < n; ++v) closest[v] = std::min(closest[v], d[v]);
+        rows.push_back(std::move(d));
+    }
+
+    landmarks_ = static_cast<int>(rows.size());
+    landmark_dist_.resize(n * rows.size());
+    for (size_t v = 0; v < n; ++v) {
+        for (size_t k = 0; k < rows.size(); ++k) landmark_dist_[v * rows.size() + k] = rows[k][v];
+    }
+}
+
+uint32_t RegionIndex::lower_bound(NodeIndex v, NodeIndex t) const {
+    const size_t k = static_cast<size_t>(landmarks_);
+    const uint16_t* dv = landmark_dist_.data() + static_cast<size_t>(v) * k;
+    const uint16_t* dt = landmark_dist_.data() + static_cast<size_t>(t) * k;
+    uint32_t best = 0;
+    for (size_t j = 0; j < k; ++j) {
+        if (dv[j] == kFar || dt[j] == kFar) continue;
+        best = std::max<uint32_t>(best, dv[j] > dt[j] ? dv[j] - dt[j] : dt[j] - dv[j]);
+    }
+    return best;
+}
+
+bool RegionIndex::shortest_path(const GateNetwork& g, NodeIndex s, NodeIndex t,
+                                std::vector<NodeIndex>& path) const {
+    path.clear();
+    if (s == t) {
+        path.push_back(s);
+        return true;
+    }
+
+    // Side 0: in-region BFS from the start; side 1: from the goal (parents
+    // then point towards the goal).
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(static_cast<size_t>(g.node_count()));
+    region_bfs(g, s, 0);
+    region_bfs(g, t, 1);
+
+    constexpr uint64_t kInf = std::numeric_limits<uint64_t>::max();
+    uint64_t best = kInf;
+    int32_t meet = -1; // last overlay node of the best route; -1: direct in-region route
+    if (ws.seen(t, 0)) best = static_cast<uint64_t>(ws.dist(t, 0));
+
+    // A* over the overlay from the start region's borders towards the goal
+    // region's, guided by landmark lower bounds. Stops once no open node can
+    // beat the best route found.
+    static thread_local SearchWorkspace overlay_ws;
+    static thread_local util::RadixHeap<int32_t> heap;
+    overlay_ws.begin(border_nodes_.size());
+    heap.clear();
+
+    auto bound = [&](int32_t o) { return static_cast<uint64_t>(lower_bound(border_nodes_[static_cast<size_t>(o)], t)); };
+    for (NodeIndex v : ws.queue(0)) {
+        int32_t o = overlay_id_[static_cast<size_t>(v)];
+        if (o < 0) continue;
+        overlay_ws.visit(o, ws.dist(v, 0), -1);
+        heap.push(static_cast<uint64_t>(ws.dist(v, 0)) + bound(o), o);
+    }
+
+    const int32_t goal_region = region_of(t);
+    while (!heap.empty()) {
+        auto [f, o] = heap.pop();
+        const uint64_t d = static_cast<uint64_t>(overlay_ws.dist(o));
+        if (f != d + bound(o)) continue; // stale
+        if (f >= best) break;
+
+        NodeIndex v = border_nodes_[static_cast<size_t>(o)];
+        if (region_of(v) == goal_region && ws.seen(v, 1)) {
+            uint64_t total = d + static_cast<uint64_t>(ws.dist(v, 1));
+            if (total < best) {
+                best = total;
+                meet = o;
+            }
+        }
+
+        for (int32_t k = offsets_[static_cast<size_t>(o)]; k < offsets_[static_cast<size_t>(o) + 1]; ++k) {
+            int32_t nxt = targets_[static_cast<size_t>(k)];
+            uint64_t nd = d + weights_[static_cast<size_t>(k)];
+            if (overlay_ws.seen(nxt) && static_cast<uint64_t>(overlay_ws.dist(nxt)) <= nd) continue;
+            overlay_ws.visit(nxt, static_cast<int32_t>(nd), o);
+            heap.push(nd + bound(nxt), nxt);
+        }
+    }
+
+    if (best == kInf) return false;
+    path.reserve(static_cast<size_t>(best) + 1);
+
+    if (meet < 0) {
+        for (NodeIndex p = t; p != -1; p = ws.parent(p, 0)) path.push_back(p);
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+
+    std::vector<int32_t> chain;
+    for (int32_t o = meet; o != -1; o = overlay_ws.parent(o)) chain.push_back(o);
+    std::reverse(chain.begin(), chain.end());
+
+    // Start and goal legs come from the first BFS pass, so take them before
+    // the workspace is reused for unpacking.
+    for (NodeIndex p = border_nodes_[static_cast<size_t>(chain.front())]; p != -1; p = ws.parent(p, 0)) {
+        path.push_back(p);
+    }
+    std::reverse(path.begin(), path.end());
+    std::vector<NodeIndex> tail;
+    for (NodeIndex p = ws.parent(border_nodes_[static_cast<size_t>(chain.back())], 1); p != -1; p = ws.parent(p, 1)) {
+        tail.push_back(p);
+    }
+
+    // Cross-region hops are single gates; in-region hops are re-expanded by BFS.
+    for (size_t k = 1; k < chain.size(); ++k) {
+        NodeIndex a = border_nodes_[static_cast<size_t>(chain[k - 1])];
+        NodeIndex b = border_nodes_[static_cast<size_t>(chain[k])];
+        if (region_of(a) != region_of(b)) {
+            path.push_back(b);
+            continue;
+        }
+        ws.begin(static_cast<size_t>(g.node_count()));
+        region_bfs(g, a, 0, b);
+        size_t mark = path.size();
+        for (NodeIndex p = b; p != a; p = ws.parent(p, 0)) path.push_back(p);
+        std::reverse(path.begin() + static_cast<std::ptrdiff_t>(mark), path.end());
+    }
+
+    path.insert(path.end(), tail.begin(), tail.end());
+    return true;
+}
+
+} // namespace universe
@@ -0,0 +1,166 @@
+#include "universe/route_planner.h"
+#include "universe/search_workspace.h"
+#include "util/radix_heap.h"
+
+#include <algorithm>
+
+namespace universe {
+
+namespace {
+
+struct HeapEntry {
+    NodeIndex node;
+    uint32_t g; // cost when pushed; stale if the node improved since
+};
+
+} // namespace
+
+RoutePlanner::RoutePlanner(const Universe& u, RouteCostProfile profile, int landmarks)
+    : g_(&u.gates()), profile_(profile) {
+    const int n = g_->node_count();
+    enter_cost_.assign(static_cast<size_t>(n), profile_.jump_cost);
+    owner_.assign(static_cast<size_t>(n), 0);
+    blocked_.assign(static_cast<size_t>(n), 0);
+
+    auto security = u.security();
+    auto owners = u.owners();
+    for (NodeIndex i = 0; i < n; ++i) {
+        auto d = u.dense_index(g_->id_at(i));
+        if (!d) continue;
+        SecurityLevel sec = security[*d];
+        enter_cost_[static_cast<size_t>(i)] += profile_.security_cost[static_cast<size_t>(sec)];
+        owner_[static_cast<size_t>(i)] = owners[*d];
+        blocked_[static_cast<size_t>(i)] = profile_.avoid_lawless && sec == SecurityLevel::None;
+    }
+
+    if (!g_->frozen() || n == 0) return;
+
+    // Farthest-point landmark selection: each new landmark maximizes its
+    // distance to the ones already chosen (unreached nodes first).
+    std::vector<uint32_t> closest;
+    dijkstra_all(0, false, closest);
+
+    std::vector<std::vector<uint32_t>> from, to;
+    for (int k = 0; k < std::min(landmarks, n); ++k) {
+        NodeIndex pick = static_cast<NodeIndex>(std::max_element(closest.begin(), closest.end()) - closest.begin());
+        if (closest[static_cast<size_t>(pick)] == 0) break;
+
+        landmarks_.push_back(pick);
+        from.emplace_back();
+        to.emplace_back();
+        dijkstra_all(pick, false, from.back());
+        dijkstra_all(pick, true, to.back());
+
+        const auto& d = from.back();
+        for (size_t v = 0; v < closest.size(); ++v) closest[v] = std::min(closest[v], d[v]);
+        closest[static_cast<size_t>(pick)] = 0;
+    }
+
+    // Node-major layout so one heuristic evaluation touches one cache line per node.
+    const size_t k = landmarks_.size();
+    lm_dist_.resize(static_cast<size_t>(n) * k * 2);
+    for (size_t v = 0; v < static_cast<size_t>(n); ++v) {
+        for (size_t j = 0; j < k; ++j) {
+            lm_dist_[(v * k + j) * 2] = from[j][v];
+            lm_dist_[(v * k + j) * 2 + 1] = to[j][v];
+        }
+    }
+}
+
+void RoutePlanner::dijkstra_all(NodeIndex src, bool reverse, std::vector<uint32_t>& out) const {
+    // Landmark tables ignore avoid_lawless: distances on the unrestricted
+    // graph are still valid lower bounds for restricted routes.
+    out.assign(static_cast<size_t>(g_->node_count()), kInf);
+
+    util::RadixHeap<NodeIndex> heap;
+    out[static_cast<size_t>(src)] = 0;
+    heap.push(0, src);
+
+    while (!heap.empty()) {
+        auto [d, u] = heap.pop();
+        if (d != out[static_cast<size_t>(u)]) continue;
+
+        for (NodeIndex v : g_->dense_neighbors(u)) {
+            uint64_t nd = d + (reverse ? edge_cost(v, u) : edge_cost(u, v));
+            if (nd < out[static_cast<size_t>(v)]) {
+                out[static_cast<size_t>(v)] = static_cast<uint32_t>(nd);
+                heap.push(nd, v);
+            }
+        }
+    }
+}
+
+uint32_t RoutePlanner::lower_bound(NodeIndex v, NodeIndex goal) const {
+    // d(v, t) >= d(L, t) - d(L, v)  and  d(v, t) >= d(v, L) - d(t, L)
+    const size_t k = landmarks_.size();
+    const uint32_t* dv = lm_dist_.data() + static_cast<size_t>(v) * k * 2;
+    const uint32_t* dt = lm_dist_.data() + static_cast<size_t>(goal) * k * 2;
+
+    uint32_t best = 0;
+    for (size_t j = 0; j < k; ++j) {
+        uint32_t from_v = dv[j * 2], to_v = dv[j * 2 + 1];
+        uint32_t from_t = dt[j * 2], to_t = dt[j * 2 + 1];
+        if (from_t != kInf && from_v != kInf && from_t > from_v) best = std::max(best, from_t - from_v);
+        if (to_v != kInf && to_t != kInf && to_v > to_t) best = std::max(best, to_v - to_t);
+    }
+    return best;
+}
+
+std::optional<WeightedRoute> RoutePlanner::route(SystemId start, SystemId goal,
+                                                 const GateOverlay* overlay) const {
+    auto s = g_->index_of(start);
+    auto t = g_->index_of(goal);
+    if (!s || !t || !g_->frozen()) return std::nullopt;
+    if (*s == *t) return WeightedRoute{0, 0, {start}};
+
+    // A landmark that reaches exactly one endpoint puts them in different components.
+    const size_t lm = landmarks_.size();
+    for (size_t j = 0; j < lm; ++j) {
+        bool reach_s = lm_dist_[(static_cast<size_t>(*s) * lm + j) * 2] != kInf;
+        bool reach_t = lm_dist_[(static_cast<size_t>(*t) * lm + j) * 2] != kInf;
+        if (reach_s != reach_t) return std::nullopt;
+    }
+
+    SearchWorkspace& ws = SearchWorkspace::local();
+    ws.begin(static_cast<size_t>(g_->node_count()));
+
+    static thread_local util::RadixHeap<HeapEntry> heap;
+    heap.clear();
+
+    ws.visit(*s, 0, -1);
+    heap.push(lower_bound(*s, *t), HeapEntry{*s, 0});
+
+    bool found = false;
+    while (!heap.empty()) {
+        auto [f, e] = heap.pop();
+        (void)f;
+        if (static_cast<uint32_t>(ws.dist(e.node)) != e.g) continue;
+        if (e.node == *t) {
+            found = true;
+            break;
+        }
+
+        auto nbrs = g_->dense_neighbors(e.node);
+        auto edges = g_->dense_edges(e.node);
+        for (size_t k = 0; k < nbrs.size(); ++k) {
+            NodeIndex v = nbrs[k];
+            if (!enterable(v, *t)) continue;
+            if (overlay && (!overlay->edge_enabled(edges[k]) || !overlay->node_enabled(v))) continue;
+            uint32_t ng = e.g + edge_cost(e.node, v);
+            if (ws.seen(v) && static_cast<uint32_t>(ws.dist(v)) <= ng) continue;
+            ws.visit(v, static_cast<int32_t>(ng), e.node);
+            heap.push(uint64_t{ng} + lower_bound(v, *t), HeapEntry{v, ng});
+        }
+    }
+
+    if (!found) return std::nullopt;
+
+    WeightedRoute wr;
+    wr.cost = static_cast<uint32_t>(ws.dist(*t));
+    for (NodeIndex p = *t; p != -1; p = ws.parent(p)) wr.path.push_back(g_->id_at(p));
+    std::reverse(wr.path.begin(), wr.path.end());
+    wr.jumps = static_cast<int>(wr.path.size()) - 1;
+    return wr;
+}
+
+} // namespace universe
@@ -0,0 +1,55 @@
+#include "universe/route_table.h"
+#include "universe/batch_bfs.h"
+#include "universe/gate_network.h"
+#include "util/parallel.h"
+
+namespace universe {
+
+void RouteTable::clear() {
+    n_ = 0;
+    dist_.clear();
+    dist_.shrink_to_fit();
+    next_.clear();
+    next_.shrink_to_fit();
+}
+
+bool RouteTable::build(const GateNetwork& g, unsigned threads) {
+    clear();
+    if (!g.frozen()) return false;
+
+    const int n = g.node_count();
+    for (NodeIndex i = 0; i < n; ++i) {
+        if (g.dense_neighbors(i).size() > kUnreachable) return false;
+    }
+
+    n_ = n;
+    dist_.resize(static_cast<size_t>(n) * static_cast<size_t>(n));
+    next_.assign(dist_.size(), kUnreachable);
+
+    if (!batch_all_pairs_u8(g, dist_.data(), threads)) {
+        clear();
+        return false;
+    }
+
+    // First hop from a towards b: the first neighbor one jump closer to b.
+    // Distances are symmetric, so neighbor k's own row gives dist(k, b).
+    util::parallel_for(static_cast<size_t>(n), [&](size_t src) {
+        const NodeIndex a = static_cast<NodeIndex>(src);
+        const uint8_t* drow = dist_.data() + at(a, 0);
+        uint8_t* nrow = next_.data() + at(a, 0);
+
+        auto nbrs = g.dense_neighbors(a);
+        for (size_t k = 0; k < nbrs.size(); ++k) {
+            const uint8_t* krow = dist_.data() + at(nbrs[k], 0);
+            for (int b = 0; b < n; ++b) {
+                if (nrow[b] == kUnreachable && drow[b] != kUnreachable && krow[b] + 1 == drow[b]) {
+                    nrow[b] = static_cast<uint8_t>(k);
+                }
+            }
+        }
+    }, threads, 8);
+
+    return true;
+}
+
+} // namespace universe
@@ -0,0 +1,25 @@
+#include "universe/search_workspace.h"
+
+namespace universe {
+
+void SearchWorkspace::begin(size_t node_count) {
+    for (int side = 0; side < kSides; ++side) {
+        if (slots_[side].size() < node_count) slots_[side].resize(node_count, Slot{0, 0, -1});
+        queue_[side].clear();
+    }
+
+    if (++epoch_ == 0) {
+        // Wrapped: old stamps could alias the new epoch, so reset once.
+        for (auto& side : slots_) {
+            for (auto& s : side) s.stamp = 0;
+        }
+        epoch_ = 1;
+    }
+}
+
+SearchWorkspace& SearchWorkspace::local() {
+    static thread_local SearchWorkspace ws;
+    return ws;
+}
+
+} // namespace universe
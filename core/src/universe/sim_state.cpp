@@ -0,0 +1,87 @@
+#include "universe/sim_state.h"
+#include "universe/universe.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+namespace universe {
+
+SimState SimState::from_universe(const Universe& u) {
+    SimState s;
+    s.owners.assign(u.owners().begin(), u.owners().end());
+    s.stock.assign(u.system_count(), 0);
+    s.fleets.assign(u.system_count(), 0);
+    return s;
+}
+
+SimStateStore::SimStateStore(SimState initial) {
+    owned_.push_back(std::make_unique<SimState>(std::move(initial)));
+    current_.store(owned_.back().get());
+}
+
+SimStateStore::~SimStateStore() = default;
+
+// Announce the epoch, then load the pointer (both seq_cst): a state this
+// reader can have loaded was still current after the announcement, so it
+// is retired with a later epoch and reclaim() leaves it alone.
+SimSnapshot SimStateStore::read() const {
+    thread_local size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    for (size_t i = 0;; ++i) {
+        size_t s = (hint + i) % kReaderSlots;
+        uint64_t idle = kIdle;
+        uint64_t e = epoch_.load();
+        if (slots_[s].epoch.compare_exchange_strong(idle, e)) {
+            hint = s;
+            return SimSnapshot(this, s, current_.load());
+        }
+        if ((i + 1) % kReaderSlots == 0) std::this_thread::yield(); // more readers than slots
+    }
+}
+
+SimState& SimStateStore::begin_tick(int64_t tick, int64_t game_seconds) {
+    reclaim();
+    SimState* next;
+    if (!free_.empty()) {
+        next = free_.back();
+        free_.pop_back();
+    } else {
+        owned_.push_back(std::make_unique<SimState>());
+        next = owned_.back().get();
+    }
+    *next = *current_.load(); // vectors keep their capacity: a copy, not an allocation
+    next->tick = tick;
+    next->game_seconds = game_seconds;
+    writing_ = next;
+    return *next;
+}
+
+void SimStateStore::publish() {
+    if (!writing_) return;
+    const SimState* old = current_.exchange(writing_);
+    uint64_t retired_at = epoch_.fetch_add(1) + 1;
+    retired_.push_back({const_cast<SimState*>(old), retired_at});
+    writing_ = nullptr;
+    ++published_;
+    reclaim();
+}
+
+void SimStateStore::reclaim() {
+    uint64_t oldest = UINT64_MAX;
+    for (const Slot& s : slots_) {
+        uint64_t e = s.epoch.load();
+        if (e != kIdle) oldest = std::min(oldest, e);
+    }
+    auto keep = std::remove_if(retired_.begin(), retired_.end(), [&](const Retired& r) {
+        if (oldest < r.epoch) return false; // a reader from before the swap may hold it
+        free_.push_back(r.state);
+        return true;
+    });
+    retired_.erase(keep, retired_.end());
+}
+
+SimStateStore::Stats SimStateStore::stats() const {
+    return {published_, owned_.size(), retired_.size()};
+}
+
+} // namespace universe
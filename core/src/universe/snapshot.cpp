@@ -0,0 +1,380 @@
+#include "universe/snapshot.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace universe {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'P', 'U', 'N', 'I', 'V', '\0', '\0'};
+constexpr uint32_t kByteOrder = 0x01020304;
+
+enum Section : uint32_t {
+    kSystemIds,
+    kSystemTypes,
+    kSystemSecurity,
+    kSystemOwners,
+    kSystemPositions,
+    kNameOffsets,
+    kNameArena,
+    kFoldedArena,
+    kFoldedOffsets,
+    kNameIds,
+    kNameSlots,
+    kNameSorted,
+    kGateIds,
+    kGateOffsets,
+    kGateTargets,
+    kGateEdges,
+    kSectionCount
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t seed;
+    uint64_t file_size;
+    uint64_t checksum; // over bytes [sizeof(Header), file_size)
+    uint32_t system_count;
+    uint32_t gate_node_count;
+    uint32_t gate_count;
+    uint32_t section_count;
+};
+
+struct SectionEntry {
+    uint32_t kind;
+    uint32_t elem_size;
+    uint64_t offset;
+    uint64_t count;
+};
+
+static_assert(sizeof(Header) % 8 == 0 && sizeof(SectionEntry) % 8 == 0);
+
+// FNV-1a over 64-bit words (bytes for the tail): any single changed word
+// changes the result, at memory speed.
+uint64_t checksum(const unsigned char* p, size_t n) {
+    uint64_t h = 1469598103934665603ull;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        h = (h ^ w) * 1099511628211ull;
+    }
+    for (; i < n; ++i) h = (h ^ p[i]) * 1099511628211ull;
+    return h;
+}
+
+size_t align8(size_t n) { return (n + 7) & ~size_t{7}; }
+
+// Read-only mapping, unmapped on scope exit.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data_ = static_cast<const unsigned char*>(p);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+    }
+    ~MappedFile() {
+        if (data_) ::munmap(const_cast<unsigned char*>(data_), size_);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+bool fail(std::string* error, const char* why) {
+    if (error) *error = why;
+    return false;
+}
+
+std::optional<Universe> load_error(std::string* error, const char* why) {
+    fail(error, why);
+    return std::nullopt;
+}
+
+} // namespace
+
+class SnapshotCodec {
+public:
+    static bool save(const Universe& u, const std::string& path, std::string* error);
+    static std::optional<Universe> load(const std::string& path, const FreezeOptions& opts, std::string* error);
+
+private:
+    struct Writer {
+        std::vector<unsigned char> buf;
+        SectionEntry table[kSectionCount]{};
+
+        template <class T>
+        void put(Section kind, std::span<const T> items) {
+            buf.resize(align8(buf.size()));
+            table[kind] = {kind, static_cast<uint32_t>(sizeof(T)), buf.size(), items.size()};
+            const auto* bytes = reinterpret_cast<const unsigned char*>(items.data());
+            buf.insert(buf.end(), bytes, bytes + items.size_bytes());
+        }
+    };
+
+    struct Reader {
+        const unsigned char* base;
+        const SectionEntry* table;
+
+        template <class T>
+        void get(Section kind, T& out) const {
+            const SectionEntry& e = table[kind];
+            const auto* p = reinterpret_cast<const typename T::value_type*>(base + e.offset);
+            out.assign(p, p + e.count);
+        }
+    };
+};
+
+bool SnapshotCodec::save(const Universe& u, const std::string& path, std::string* error) {
+    // CSR arrays only exist on a frozen network; freeze a bare copy if needed.
+    GateNetwork unfrozen_copy;
+    const GateNetwork* g = &u.gates_;
+    if (!g->frozen()) {
+        unfrozen_copy = u.gates_;
+        unfrozen_copy.freeze({.route_table = false, .region_index = false});
+        g = &unfrozen_copy;
+    }
+    const NameIndex& ni = u.names_;
+
+    Writer w;
+    w.buf.resize(sizeof(Header) + sizeof(w.table));
+    w.put<SystemId>(kSystemIds, u.ids_);
+    w.put<SystemType>(kSystemTypes, u.types_);
+    w.put<SecurityLevel>(kSystemSecurity, u.security_);
+    w.put<int32_t>(kSystemOwners, u.owners_);
+    w.put<Vec3>(kSystemPositions, u.positions_);
+    w.put<uint32_t>(kNameOffsets, u.name_offsets_);
+    w.put<char>(kNameArena, u.names_arena_);
+    w.put<char>(kFoldedArena, ni.folded_);
+    w.put<uint32_t>(kFoldedOffsets, ni.offsets_);
+    w.put<SystemId>(kNameIds, ni.ids_);
+    w.put<uint32_t>(kNameSlots, ni.slots_);
+    w.put<uint32_t>(kNameSorted, ni.sorted_);
+    w.put<SystemId>(kGateIds, g->ids_);
+    w.put<int32_t>(kGateOffsets, g->offsets_);
+    w.put<NodeIndex>(kGateTargets, g->targets_);
+    w.put<EdgeIndex>(kGateEdges, g->edge_ids_);
+    w.buf.resize(align8(w.buf.size()));
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kSnapshotVersion;
+    h.byte_order = kByteOrder;
+    h.seed = u.seed_;
+    h.file_size = w.buf.size();
+    h.system_count = static_cast<uint32_t>(u.ids_.size());
+    h.gate_node_count = static_cast<uint32_t>(g->node_count());
+    h.gate_count = static_cast<uint32_t>(g->gate_count());
+    h.section_count = kSectionCount;
+    std::memcpy(w.buf.data() + sizeof(Header), w.table, sizeof(w.table));
+    h.checksum = checksum(w.buf.data() + sizeof(Header), w.buf.size() - sizeof(Header));
+    std::memcpy(w.buf.data(), &h, sizeof(h));
+
+    std::string tmp = path + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (!f) return fail(error, "cannot open file for writing");
+    bool ok = std::fwrite(w.buf.data(), 1, w.buf.size(), f) == w.buf.size();
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return fail(error, "write failed");
+    }
+    return true;
+}
+
+std::optional<Universe> SnapshotCodec::load(const std::string& path, const FreezeOptions& opts,
+                                            std::string* error) {
+    MappedFile file(path);
+    if (!file.data()) return load_error(error, "cannot map file");
+    if (file.size() < sizeof(Header) + sizeof(SectionEntry) * kSectionCount) {
+        return load_error(error, "file too small");
+    }
+
+    Header h;
+    std::memcpy(&h, file.data(), sizeof(h));
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) return load_error(error, "not a universe snapshot");
+    if (h.byte_order != kByteOrder) return load_error(error, "byte order mismatch");
+    if (h.version != kSnapshotVersion) return load_error(error, "unsupported snapshot version");
+    if (h.file_size != file.size() || h.section_count != kSectionCount) {
+        return load_error(error, "truncated or malformed file");
+    }
+    if (checksum(file.data() + sizeof(Header), file.size() - sizeof(Header)) != h.checksum) {
+        return load_error(error, "checksum mismatch");
+    }
+
+    // Element size of each section as written by save(); Reader::get reads
+    // count * sizeof(T), so any other size would read past the section.
+    constexpr uint32_t kElemSize[kSectionCount] = {
+        sizeof(SystemId), sizeof(SystemType), sizeof(SecurityLevel), sizeof(int32_t), sizeof(Vec3),
+        sizeof(uint32_t), sizeof(char), sizeof(char), sizeof(uint32_t), sizeof(SystemId),
+        sizeof(uint32_t), sizeof(uint32_t), sizeof(SystemId), sizeof(int32_t), sizeof(NodeIndex),
+        sizeof(EdgeIndex),
+    };
+
+    SectionEntry table[kSectionCount];
+    std::memcpy(table, file.data() + sizeof(Header), sizeof(table));
+    for (uint32_t k = 0; k < kSectionCount; ++k) {
+        const SectionEntry& e = table[k];
+        if (e.kind != k || e.elem_size != kElemSize[k] || e.offset % 8 != 0 || e.offset > file.size() ||
+            e.count > (file.size() - e.offset) / e.elem_size) {
+            return load_error(error, "bad section table");
+        }
+    }
+
+    // Cheap structural checks so a consistent-but-wrong file can't index out of range.
+    const uint64_t n = h.system_count, gn = h.gate_node_count;
+    auto count = [&](Section s) { return table[s].count; };
+    if (count(kSystemIds) != n || count(kSystemTypes) != n || count(kSystemSecurity) != n ||
+        count(kSystemOwners) != n || count(kSystemPositions) != n || count(kNameOffsets) != n + 1 ||
+        count(kGateIds) != gn || count(kGateOffsets) != gn + 1 || count(kGateTargets) != count(kGateEdges) ||
+        count(kGateTargets) != 2 * uint64_t{h.gate_count} ||
+        count(kFoldedOffsets) != count(kNameIds) + 1 || count(kNameSorted) != count(kNameIds)) {
+        return load_error(error, "inconsistent section sizes");
+    }
+
+    Universe u;
+    Reader r{file.data(), table};
+    u.seed_ = h.seed;
+    r.get(kSystemIds, u.ids_);
+    r.get(kSystemTypes, u.types_);
+    r.get(kSystemSecurity, u.security_);
+    r.get(kSystemOwners, u.owners_);
+    r.get(kSystemPositions, u.positions_);
+    r.get(kNameOffsets, u.name_offsets_);
+    r.get(kNameArena, u.names_arena_);
+
+    NameIndex& ni = u.names_;
+    r.get(kFoldedArena, ni.folded_);
+    r.get(kFoldedOffsets, ni.offsets_);
+    r.get(kNameIds, ni.ids_);
+    r.get(kNameSlots, ni.slots_);
+    r.get(kNameSorted, ni.sorted_);
+
+    GateNetwork& g = u.gates_;
+    r.get(kGateIds, g.ids_);
+    r.get(kGateOffsets, g.offsets_);
+    r.get(kGateTargets, g.targets_);
+    r.get(kGateEdges, g.edge_ids_);
+
+    // Enum bytes index per-value tables (e.g. RoutePlanner's security costs).
+    for (SystemType t : u.types_) {
+        if (static_cast<uint8_t>(t) > static_cast<uint8_t>(SystemType::Dead)) return load_error(error, "bad system type");
+    }
+    for (SecurityLevel s : u.security_) {
+        if (static_cast<uint8_t>(s) > static_cast<uint8_t>(SecurityLevel::None)) {
+            return load_error(error, "bad security level");
+        }
+    }
+
+    auto monotone = [](const std::vector<uint32_t>& off, size_t limit) {
+        if (off.front() != 0 || off.back() != limit) return false;
+        for (size_t i = 1; i < off.size(); ++i) {
+            if (off[i] < off[i - 1]) return false;
+        }
+        return true;
+    };
+    std::vector<uint32_t> gate_off(g.offsets_.begin(), g.offsets_.end());
+    bool ok = monotone(u.name_offsets_, u.names_arena_.size()) && monotone(ni.offsets_, ni.folded_.size()) &&
+              monotone(gate_off, g.targets_.size()) &&
+              (ni.slots_.empty() || (ni.slots_.size() & (ni.slots_.size() - 1)) == 0);
+    // Probing stops at an empty slot; a full table would never terminate.
+    ok = ok && (ni.slots_.empty() || std::find(ni.slots_.begin(), ni.slots_.end(), 0u) != ni.slots_.end());
+    for (uint32_t s : ni.slots_) ok = ok && s <= ni.ids_.size();
+    for (uint32_t e : ni.sorted_) ok = ok && e < ni.ids_.size();
+    for (NodeIndex t : g.targets_) ok = ok && t >= 0 && static_cast<uint64_t>(t) < gn;
+    for (EdgeIndex e : g.edge_ids_) ok = ok && e >= 0 && static_cast<uint64_t>(e) < h.gate_count;
+    if (!ok) return load_error(error, "corrupt index data");
+
+    // Dense id maps: arithmetic while ids are contiguous, hashed otherwise.
+    auto contiguous = [](const std::vector<SystemId>& ids) {
+        for (size_t i = 1; i < ids.size(); ++i) {
+            if (ids[i] != ids[0] + static_cast<SystemId>(i)) return false;
+        }
+        return true;
+    };
+    u.contiguous_ = contiguous(u.ids_);
+    if (!u.contiguous_) {
+        for (uint32_t i = 0; i < u.ids_.size(); ++i) ok = ok && u.index_.emplace(u.ids_[i], i).second;
+    }
+    g.contiguous_ = contiguous(g.ids_);
+    if (!g.contiguous_) {
+        for (NodeIndex i = 0; i < static_cast<NodeIndex>(g.ids_.size()); ++i) {
+            ok = ok && g.index_.emplace(g.ids_[static_cast<size_t>(i)], i).second;
+        }
+    }
+    if (!ok) return load_error(error, "duplicate system ids");
+
+    // Gates join known systems, and every half-edge has its reverse with
+    // the same gate id; each gate id is used by exactly one such pair.
+    // BFS, the route table and Tarjan all assume an undirected graph.
+    for (SystemId id : g.ids_) ok = ok && u.dense_index(id).has_value();
+    std::vector<uint8_t> uses(h.gate_count, 0);
+    for (NodeIndex i = 0; ok && i < static_cast<NodeIndex>(gn); ++i) {
+        auto nbrs = g.dense_neighbors(i);
+        auto edges = g.dense_edges(i);
+        for (size_t k = 0; ok && k < nbrs.size(); ++k) {
+            const NodeIndex j = nbrs[k];
+            bool reverse = false;
+            auto back = g.dense_neighbors(j);
+            for (size_t r = 0; r < back.size() && !reverse; ++r) reverse = back[r] == i && g.dense_edges(j)[r] == edges[k];
+            ok = j != i && reverse && ++uses[static_cast<size_t>(edges[k])] <= 2;
+        }
+    }
+    if (!ok) return load_error(error, "corrupt gate data");
+
+    // Derived gate state: neighbor ids, connectivity, then optional indexes.
+    g.target_ids_.resize(g.targets_.size());
+    for (size_t k = 0; k < g.targets_.size(); ++k) g.target_ids_[k] = g.ids_[static_cast<size_t>(g.targets_[k])];
+    g.gate_count_ = static_cast<int>(h.gate_count);
+    g.uf_parent_.resize(gn);
+    g.uf_rank_.assign(gn, 0);
+    for (NodeIndex i = 0; i < static_cast<NodeIndex>(gn); ++i) g.uf_parent_[static_cast<size_t>(i)] = i;
+    g.components_ = static_cast<int>(gn);
+    for (NodeIndex i = 0; i < static_cast<NodeIndex>(gn); ++i) {
+        for (NodeIndex j : g.dense_neighbors(i)) {
+            if (j > i) g.uf_union(i, j);
+        }
+    }
+    for (NodeIndex i = 0; i < static_cast<NodeIndex>(gn); ++i) g.uf_find(i);
+    g.topology_version_++;
+    g.frozen_ = true;
+    g.freeze(opts);
+    u.build_spatial_index();
+
+    return u;
+}
+
+bool save_snapshot(const Universe& u, const std::string& path, std::string* error) {
+    return SnapshotCodec::save(u, path, error);
+}
+
+std::optional<Universe> load_snapshot(const std::string& path, const FreezeOptions& opts, std::string* error) {
+    return SnapshotCodec::load(path, opts, error);
+}
+
+} // namespace universe
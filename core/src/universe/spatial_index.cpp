@@ -0,0 +1,190 @@
+#include "universe/spatial_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace universe {
+
+namespace {
+
+constexpr double kPointsPerCell = 2.0;
+
+bool hit_less(const SpatialHit& a, const SpatialHit& b) {
+    return a.distance != b.distance ? a.distance < b.distance : a.index < b.index;
+}
+
+} // namespace
+
+void SpatialIndex::clear() {
+    cell_start_.clear();
+    index_.clear();
+    points_.clear();
+    dims_[0] = dims_[1] = dims_[2] = 0;
+}
+
+int32_t SpatialIndex::cell_coord(float v, float origin, int axis) const {
+    float c = std::floor((v - origin) * inv_cell_);
+    if (!(c >= 0.0f)) return 0; // also catches NaN
+    if (c >= static_cast<float>(dims_[axis])) return dims_[axis] - 1;
+    return static_cast<int32_t>(c);
+}
+
+void SpatialIndex::build(std::span<const Vec3> points, float cell_size) {
+    clear();
+    if (points.empty()) return;
+
+    Vec3 lo = points[0], hi = points[0];
+    for (const Vec3& p : points) {
+        lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+        hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+    }
+    const double extent[3] = {double(hi.x) - lo.x, double(hi.y) - lo.y, double(hi.z) - lo.z};
+
+    // Pick the cell size so the grid has about n / kPointsPerCell cells. An
+    // axis thinner than one cell contributes a single layer, so solve for
+    // the size a few times with those axes pinned.
+    double cell = cell_size;
+    if (cell <= 0) {
+        const double target = std::max(1.0, static_cast<double>(points.size()) / kPointsPerCell);
+        double vol = 1.0;
+        for (double e : extent) vol *= std::max(e, 1e-3);
+        cell = std::cbrt(vol / target);
+        for (int iter = 0; iter < 4; ++iter) {
+            double v = 1.0;
+            for (double e : extent) v *= std::max(e, cell);
+            cell = std::cbrt(v / target);
+        }
+        if (!(cell > 0)) cell = 1.0;
+    }
+
+    // Cap the cell count at a few per point even for an explicit cell size.
+    const double max_cells = 4.0 * static_cast<double>(points.size()) + 64.0;
+    for (;;) {
+        double cells = 1.0;
+        for (int a = 0; a < 3; ++a) cells *= std::floor(extent[a] / cell) + 1.0;
+        if (cells <= max_cells) break;
+        cell *= 1.25;
+    }
+
+    cell_ = static_cast<float>(cell);
+    inv_cell_ = static_cast<float>(1.0 / cell);
+    origin_ = lo;
+    for (int a = 0; a < 3; ++a) dims_[a] = static_cast<int32_t>(std::floor(extent[a] / cell)) + 1;
+
+    // Counting sort of the points by cell.
+    const size_t cells = static_cast<size_t>(dims_[0]) * static_cast<size_t>(dims_[1]) * static_cast<size_t>(dims_[2]);
+    std::vector<uint32_t> cell_of(points.size());
+    cell_start_.assign(cells + 1, 0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Vec3& p = points[i];
+        size_t c = cell_id(cell_coord(p.x, origin_.x, 0), cell_coord(p.y, origin_.y, 1), cell_coord(p.z, origin_.z, 2));
+        cell_of[i] = static_cast<uint32_t>(c);
+        ++cell_start_[c + 1];
+    }
+    for (size_t c = 0; c < cells; ++c) cell_start_[c + 1] += cell_start_[c];
+
+    index_.resize(points.size());
+    points_.resize(points.size());
+    std::vector<uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+    for (size_t i = 0; i < points.size(); ++i) {
+        uint32_t slot = fill[cell_of[i]]++;
+        index_[slot] = static_cast<uint32_t>(i);
+        points_[slot] = points[i];
+    }
+}
+
+std::vector<SpatialHit> SpatialIndex::within(const Vec3& center, float radius) const {
+    std::vector<SpatialHit> out;
+    if (empty() || !(radius >= 0.0f)) return out;
+
+    const float r2 = radius * radius;
+    int32_t x0 = cell_coord(center.x - radius, origin_.x, 0), x1 = cell_coord(center.x + radius, origin_.x, 0);
+    int32_t y0 = cell_coord(center.y - radius, origin_.y, 1), y1 = cell_coord(center.y + radius, origin_.y, 1);
+    int32_t z0 = cell_coord(center.z - radius, origin_.z, 2), z1 = cell_coord(center.z + radius, origin_.z, 2);
+
+    for (int32_t z = z0; z <= z1; ++z) {
+        for (int32_t y = y0; y <= y1; ++y) {
+            // Cells along x are adjacent in memory: scan the whole row at once.
+            uint32_t begin = cell_start_[cell_id(x0, y, z)], end = cell_start_[cell_id(x1, y, z) + 1];
+            for (uint32_t k = begin; k < end; ++k) {
+                float d2 = distance_sq(points_[k], center);
+                if (d2 <= r2) out.push_back({index_[k], std::sqrt(d2)});
+            }
+        }
+    }
+    std::sort(out.begin(), out.end(), hit_less);
+    return out;
+}
+
+std::vector<SpatialHit> SpatialIndex::nearest(const Vec3& center, size_t k) const {
+    std::vector<SpatialHit> out;
+    k = std::min(k, size());
+    if (k == 0) return out;
+
+    // The k best (squared distance, index) seen so far, kept sorted; k is
+    // small in practice, so insertion beats a heap.
+    using Entry = std::pair<float, uint32_t>;
+    std::vector<Entry> best;
+    best.reserve(k + 1);
+    float worst = std::numeric_limits<float>::infinity();
+    auto visit = [&](int32_t x, int32_t y, int32_t z) {
+        size_t c = cell_id(x, y, z);
+        for (uint32_t s = cell_start_[c]; s < cell_start_[c + 1]; ++s) {
+            float d2 = distance_sq(points_[s], center);
+            if (d2 > worst) continue;
+            Entry e{d2, index_[s]};
+            best.insert(std::upper_bound(best.begin(), best.end(), e), e);
+            if (best.size() > k) best.pop_back();
+            if (best.size() == k) worst = best.back().first;
+        }
+    };
+
+    const int32_t cx = cell_coord(center.x, origin_.x, 0);
+    const int32_t cy = cell_coord(center.y, origin_.y, 1);
+    const int32_t cz = cell_coord(center.z, origin_.z, 2);
+    const int32_t max_ring = std::max({cx, dims_[0] - 1 - cx, cy, dims_[1] - 1 - cy, cz, dims_[2] - 1 - cz});
+
+    for (int32_t r = 0; r <= max_ring; ++r) {
+        // Visit the cells at Chebyshev distance exactly r from the centre cell.
+        int32_t x0 = std::max(cx - r, 0), x1 = std::min(cx + r, dims_[0] - 1);
+        int32_t y0 = std::max(cy - r, 0), y1 = std::min(cy + r, dims_[1] - 1);
+        for (int32_t x = x0; x <= x1; ++x) {
+            for (int32_t y = y0; y <= y1; ++y) {
+                if (std::abs(x - cx) == r || std::abs(y - cy) == r) {
+                    for (int32_t z = std::max(cz - r, 0); z <= std::min(cz + r, dims_[2] - 1); ++z) visit(x, y, z);
+                } else {
+                    if (cz - r >= 0) visit(x, y, cz - r);
+                    if (r > 0 && cz + r < dims_[2]) visit(x, y, cz + r);
+                }
+            }
+        }
+
+        // Everything closer than the nearest face of the searched block has
+        // been seen; faces on the grid boundary have nothing beyond them.
+        if (best.size() == k) {
+            float reach = std::numeric_limits<float>::infinity();
+            const int32_t c[3] = {cx, cy, cz};
+            const float p[3] = {center.x, center.y, center.z};
+            const float o[3] = {origin_.x, origin_.y, origin_.z};
+            for (int a = 0; a < 3; ++a) {
+                if (c[a] - r > 0) reach = std::min(reach, p[a] - (o[a] + static_cast<float>(c[a] - r) * cell_));
+                if (c[a] + r < dims_[a] - 1) {
+                    reach = std::min(reach, (o[a] + static_cast<float>(c[a] + r + 1) * cell_) - p[a]);
+                }
+            }
+            reach -= cell_ * 1e-4f; // slack for rounding in cell assignment
+            if (reach >= 0.0f && worst <= reach * reach) break;
+        }
+    }
+
+    out.reserve(best.size());
+    for (const Entry& e : best) out.push_back({e.second, std::sqrt(e.first)});
+    return out;
+}
+
+size_t SpatialIndex::memory_bytes() const {
+    return (cell_start_.capacity() + index_.capacity()) * sizeof(uint32_t) + points_.capacity() * sizeof(Vec3);
+}
+
+} // namespace universe
@@ -0,0 +1,168 @@
+#include "universe/system_contents.h"
+#include "util/counter_rng.h"
+
+#include <algorithm>
+
+namespace universe {
+
+namespace {
+
+constexpr uint32_t kContentsStream = 0x626f6479; // "body"
+
+BodyClass planet_class(util::CounterRng& rng, float au) {
+    uint32_t roll = rng.uniform(100);
+    if (au < 0.4f) return roll < 60 ? BodyClass::Lava : BodyClass::Rocky;
+    if (au < 1.6f) return roll < 40 ? BodyClass::Rocky : roll < 70 ? BodyClass::Ocean : BodyClass::Desert;
+    if (au < 5.0f) return roll < 35 ? BodyClass::Rocky : roll < 55 ? BodyClass::Desert : BodyClass::GasGiant;
+    return roll < 65 ? BodyClass::GasGiant : BodyClass::Ice;
+}
+
+uint8_t richness(util::CounterRng& rng, SystemType type) {
+    switch (type) {
+    case SystemType::Core: return static_cast<uint8_t>(rng.between(5, 60));
+    case SystemType::Frontier: return static_cast<uint8_t>(rng.between(20, 90));
+    case SystemType::Dead: return static_cast<uint8_t>(rng.between(0, 100));
+    }
+    return 0;
+}
+
+} // namespace
+
+SystemContents generate_system_contents(uint64_t seed, SystemId id, SystemType type) {
+    util::CounterRng rng(seed, kContentsStream, static_cast<uint32_t>(id));
+    SystemContents out;
+    out.system = id;
+
+    int planets = type == SystemType::Core ? rng.between(4, 10) : type == SystemType::Frontier ? rng.between(2, 8) : rng.between(0, 5);
+    int belts = rng.between(0, 2);
+
+    // Orbits grow geometrically (Titius-Bode-like); belts take some of the
+    // slots, so they sit between planets.
+    std::vector<bool> is_belt(static_cast<size_t>(planets + belts), false);
+    for (int b = 0; b < belts; ++b) {
+        size_t slot;
+        do slot = rng.uniform(static_cast<uint32_t>(is_belt.size()));
+        while (is_belt[slot]);
+        is_belt[slot] = true;
+    }
+
+    float au = static_cast<float>(0.2 + 0.3 * rng.unit());
+    for (bool belt : is_belt) {
+        Body body;
+        body.orbit_au = au;
+        body.richness = richness(rng, type);
+        if (belt) {
+            body.type = BodyType::AsteroidBelt;
+            out.bodies.push_back(body);
+        } else {
+            body.type = BodyType::Planet;
+            body.body_class = planet_class(rng, au);
+            auto parent = static_cast<int16_t>(out.bodies.size());
+            out.bodies.push_back(body);
+
+            int moons = body.body_class == BodyClass::GasGiant ? rng.between(1, 6)
+                        : body.body_class == BodyClass::Lava   ? 0
+                                                               : rng.between(0, 2);
+            for (int m = 0; m < moons; ++m) {
+                Body moon;
+                moon.type = BodyType::Moon;
+                moon.body_class = au < 3.0f ? BodyClass::Rocky : BodyClass::Ice;
+                moon.parent = parent;
+                moon.orbit_au = au;
+                moon.richness = richness(rng, type);
+                out.bodies.push_back(moon);
+            }
+        }
+        au *= static_cast<float>(1.4 + 0.6 * rng.unit());
+    }
+    return out;
+}
+
+std::shared_ptr<const SystemContents> SystemContentsCache::build(SystemId id) const {
+    auto i = u_->dense_index(id);
+    if (!i) return nullptr;
+    auto c = std::make_shared<SystemContents>(generate_system_contents(u_->seed(), id, u_->types()[*i]));
+    if (auto it = changes_.find(id); it != changes_.end()) {
+        for (const BodyChange& ch : it->second) {
+            Body& b = c->bodies[ch.body];
+            if (ch.owner_faction_id) b.owner_faction_id = *ch.owner_faction_id;
+            if (ch.richness) b.richness = *ch.richness;
+        }
+    }
+    return c;
+}
+
+void SystemContentsCache::put(SystemId id, std::shared_ptr<const SystemContents> contents) {
+    if (auto it = cached_.find(id); it != cached_.end()) {
+        it->second->second = std::move(contents);
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+    if (capacity_ == 0) return;
+    if (lru_.size() >= capacity_) {
+        cached_.erase(lru_.back().first);
+        lru_.pop_back();
+        ++evictions_;
+    }
+    lru_.emplace_front(id, std::move(contents));
+    cached_[id] = lru_.begin();
+}
+
+std::shared_ptr<const SystemContents> SystemContentsCache::get(SystemId id) {
+    std::lock_guard lock(mu_);
+    if (auto it = cached_.find(id); it != cached_.end()) {
+        ++hits_;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+    }
+    auto c = build(id);
+    if (!c) return nullptr;
+    ++misses_;
+    put(id, c);
+    return c;
+}
+
+bool SystemContentsCache::apply(const BodyChange& change) {
+    std::lock_guard lock(mu_);
+    std::shared_ptr<const SystemContents> current;
+    if (auto it = cached_.find(change.system); it != cached_.end()) {
+        current = it->second->second;
+    } else {
+        current = build(change.system);
+        if (!current) return false;
+        ++misses_;
+    }
+    if (change.body >= current->bodies.size()) return false;
+
+    auto& list = changes_[change.system];
+    auto it = std::lower_bound(list.begin(), list.end(), change.body,
+                               [](const BodyChange& c, uint16_t body) { return c.body < body; });
+    if (it == list.end() || it->body != change.body) it = list.insert(it, {change.system, change.body, {}, {}});
+    if (change.owner_faction_id) it->owner_faction_id = change.owner_faction_id;
+    if (change.richness) it->richness = change.richness;
+
+    // Copy-on-write: readers holding the old snapshot keep it unchanged.
+    auto next = std::make_shared<SystemContents>(*current);
+    Body& b = next->bodies[change.body];
+    if (change.owner_faction_id) b.owner_faction_id = *change.owner_faction_id;
+    if (change.richness) b.richness = *change.richness;
+    put(change.system, std::move(next));
+    return true;
+}
+
+std::vector<BodyChange> SystemContentsCache::changes() const {
+    std::lock_guard lock(mu_);
+    std::vector<BodyChange> out;
+    for (const auto& [id, list] : changes_) out.insert(out.end(), list.begin(), list.end());
+    std::sort(out.begin(), out.end(), [](const BodyChange& a, const BodyChange& b) {
+        return a.system != b.system ? a.system < b.system : a.body < b.body;
+    });
+    return out;
+}
+
+SystemContentsCache::Stats SystemContentsCache::stats() const {
+    std::lock_guard lock(mu_);
+    return {lru_.size(), capacity_, hits_, misses_, evictions_, changes_.size()};
+}
+
+} // namespace universe
@@ -1,25 +1,135 @@
 #include "universe/universe.h"
 
+#include <algorithm>
+
 namespace universe {
 
 bool Universe::add_system(SolarSystem sys) {
-    if (systems_.contains(sys.id)) return false;
-    systems_.emplace(sys.id, sys);
+    if (dense_index(sys.id)) return false;
+
+    auto i = static_cast<uint32_t>(ids_.size());
+    if (contiguous_ && !ids_.empty() && sys.id != ids_.front() + static_cast<SystemId>(i)) {
+        index_.reserve(ids_.size() + 1);
+        for (uint32_t k = 0; k < i; ++k) index_.emplace(ids_[k], k);
+        contiguous_ = false;
+    }
+    if (!contiguous_) index_.emplace(sys.id, i);
+    ids_.push_back(sys.id);
+    types_.push_back(sys.type);
+    security_.push_back(sys.security);
+    owners_.push_back(sys.owner_faction_id);
+    positions_.push_back(sys.position);
+    names_arena_ += sys.name;
+    name_offsets_.push_back(static_cast<uint32_t>(names_arena_.size()));
+
+    names_.add(sys.name, sys.id);
+    spatial_.clear();
     gates_.add_node(sys.id);
     return true;
 }
 
-std::optional<SolarSystem> Universe::get_system(SystemId id) const {
-    auto it = systems_.find(id);
-    if (it == systems_.end()) return std::nullopt;
+std::optional<uint32_t> Universe::dense_index(SystemId id) const {
+    if (contiguous_) {
+        if (ids_.empty()) return std::nullopt;
+        int64_t i = static_cast<int64_t>(id) - ids_.front();
+        if (i < 0 || i >= static_cast<int64_t>(ids_.size())) return std::nullopt;
+        return static_cast<uint32_t>(i);
+    }
+    auto it = index_.find(id);
+    if (it == index_.end()) return std::nullopt;
     return it->second;
 }
 
-std::optional<SystemId> Universe::find_system_by_name(const std::string& name) const {
-    for (const auto& [id, sys] : systems_) {
-        if (sys.name == name) return id;
+std::optional<SolarSystem> Universe::get_system(SystemId id) const {
+    auto i = dense_index(id);
+    if (!i) return std::nullopt;
+    SystemView v = view_at(*i);
+    return SolarSystem{v.id, std::string(v.name), v.type, v.security, v.owner_faction_id, v.position};
+}
+
+std::optional<SystemView> Universe::view(SystemId id) const {
+    auto i = dense_index(id);
+    if (!i) return std::nullopt;
+    return view_at(*i);
+}
+
+std::string_view Universe::name_of(SystemId id) const {
+    auto i = dense_index(id);
+    return i ? name_at(*i) : std::string_view{};
+}
+
+void Universe::names_of(std::span<const SystemId> ids, std::span<std::string_view> out) const {
+    for (size_t k = 0; k < ids.size() && k < out.size(); ++k) out[k] = name_of(ids[k]);
+}
+
+void Universe::views_of(std::span<const SystemId> ids, std::span<SystemView> out) const {
+    for (size_t k = 0; k < ids.size() && k < out.size(); ++k) {
+        auto i = dense_index(ids[k]);
+        if (i) {
+            out[k] = view_at(*i);
+        } else {
+            out[k] = SystemView{};
+            out[k].id = ids[k];
+        }
+    }
+}
+
+std::optional<SystemId> Universe::find_system_by_name(std::string_view name) const {
+    return names_.find(name);
+}
+
+std::vector<SystemId> Universe::find_systems_by_prefix(std::string_view prefix, size_t limit) const {
+    return names_.find_prefix(prefix, limit);
+}
+
+void Universe::build_spatial_index(float cell_size_ly) {
+    spatial_.build(positions_, cell_size_ly);
+}
+
+namespace {
+
+std::vector<SystemDistance> to_systems(const Universe& u, const std::vector<SpatialHit>& hits) {
+    std::vector<SystemDistance> out;
+    out.reserve(hits.size());
+    for (const SpatialHit& h : hits) out.push_back({u.id_at(h.index), h.distance});
+    return out;
+}
+
+} // namespace
+
+std::vector<SystemDistance> Universe::systems_within_ly(const Vec3& center, float ly) const {
+    if (!spatial_.empty()) return to_systems(*this, spatial_.within(center, ly));
+    std::vector<SpatialHit> hits;
+    for (uint32_t i = 0; i < positions_.size(); ++i) {
+        float d = distance(positions_[i], center);
+        if (d <= ly) hits.push_back({i, d});
     }
-    return std::nullopt;
+    std::sort(hits.begin(), hits.end(), [](const SpatialHit& a, const SpatialHit& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.index < b.index;
+    });
+    return to_systems(*this, hits);
+}
+
+std::vector<SystemDistance> Universe::nearest_systems(const Vec3& center, size_t k) const {
+    if (!spatial_.empty()) return to_systems(*this, spatial_.nearest(center, k));
+    std::vector<SpatialHit> hits(positions_.size());
+    for (uint32_t i = 0; i < positions_.size(); ++i) hits[i] = {i, distance(positions_[i], center)};
+    auto by_distance = [](const SpatialHit& a, const SpatialHit& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.index < b.index;
+    };
+    k = std::min(k, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(k), hits.end(), by_distance);
+    hits.resize(k);
+    return to_systems(*this, hits);
+}
+
+size_t Universe::memory_bytes() const {
+    // unordered_map nodes: key/value pair plus next pointer and cached hash, plus a bucket slot.
+    constexpr size_t kMapEntry = sizeof(std::pair<const SystemId, uint32_t>) + 2 * sizeof(void*) + sizeof(void*);
+    return ids_.capacity() * sizeof(SystemId) + types_.capacity() + security_.capacity() +
+           owners_.capacity() * sizeof(int32_t) + positions_.capacity() * sizeof(Vec3) + names_arena_.capacity() +
+           name_offsets_.capacity() * sizeof(uint32_t) + index_.size() * kMapEntry + names_.memory_bytes() +
+           spatial_.memory_bytes();
 }
 
 } // namespace universe
@@ -0,0 +1,109 @@
+#include "util/work_stealing_pool.h"
+#include "util/parallel.h"
+
+#include <algorithm>
+
+namespace util {
+
+struct WorkStealingPool::Job {
+    const ChunkFn* fn = nullptr;
+    size_t remaining = 0; // chunks not finished yet; guarded by done_mu
+    std::mutex done_mu;
+    std::condition_variable done;
+};
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    unsigned n = worker_count(threads);
+    for (unsigned i = 0; i < n; ++i) queues_.push_back(std::make_unique<Queue>());
+    for (unsigned i = 1; i < n; ++i) workers_.emplace_back([this, i] { worker_loop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard lock(wake_mu_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& w : workers_) w.join();
+}
+
+// Pops own newest task, else steals the oldest from the next non-empty
+// queue after ours. Runs it and reports whether there was one.
+bool WorkStealingPool::try_run_one(unsigned self) {
+    Task t;
+    bool found = false;
+    {
+        Queue& q = *queues_[self];
+        std::lock_guard lock(q.mu);
+        if (!q.tasks.empty()) {
+            t = q.tasks.back();
+            q.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (unsigned k = 1; !found && k < queues_.size(); ++k) {
+        Queue& q = *queues_[(self + k) % queues_.size()];
+        std::lock_guard lock(q.mu);
+        if (!q.tasks.empty()) {
+            t = q.tasks.front();
+            q.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) return false;
+
+    (*t.job->fn)(t.begin, t.end, self);
+    // Count down under the lock: once the caller sees zero it destroys the job.
+    std::lock_guard lock(t.job->done_mu);
+    if (--t.job->remaining == 0) t.job->done.notify_all();
+    return true;
+}
+
+void WorkStealingPool::worker_loop(unsigned self) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock lock(wake_mu_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        while (try_run_one(self)) {
+        }
+    }
+}
+
+void WorkStealingPool::run(size_t count, size_t grain, const ChunkFn& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    std::lock_guard run_lock(run_mu_);
+
+    Job job;
+    job.fn = &fn;
+    const size_t chunks = (count + grain - 1) / grain;
+    job.remaining = chunks;
+
+    // Deal contiguous runs of chunks to each participant (neighbouring
+    // systems stay on one thread); stealing evens out the rest.
+    const size_t parts = queues_.size();
+    for (size_t p = 0; p < parts; ++p) {
+        size_t c0 = chunks * p / parts, c1 = chunks * (p + 1) / parts;
+        Queue& q = *queues_[p];
+        std::lock_guard lock(q.mu);
+        // Pushed in reverse so the owner, popping from the back, walks its
+        // run in order while thieves take from the far end.
+        for (size_t c = c1; c-- > c0;) q.tasks.push_back({&job, c * grain, std::min(count, (c + 1) * grain)});
+    }
+    {
+        std::lock_guard lock(wake_mu_);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    while (try_run_one(0)) {
+    }
+    std::unique_lock lock(job.done_mu);
+    job.done.wait(lock, [&] { return job.remaining == 0; });
+}
+
+} // namespace util
@@ -1,8 +1,10 @@
 #pragma once
 
 namespace commands { class Router; }
-namespace sim { class GameClock; }
+namespace sim { class GameClock; class TickScheduler; class TickLoop; }
 
 namespace sim_cmd {
 void register_time_commands(commands::Router& r, const sim::GameClock& clock);
+void register_phase_commands(commands::Router& r, const sim::TickScheduler& scheduler);
+void register_tick_loop_commands(commands::Router& r, const sim::TickLoop& loop);
 }
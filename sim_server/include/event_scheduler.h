@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+// Identifies one scheduled event. Slots are reused, so a stale handle
+// (event fired or cancelled) is recognised by its generation.
+struct EventHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != UINT32_MAX; }
+};
+
+using EventKind = uint16_t;
+
+struct ScheduledEvent {
+    EventHandle handle;
+    int64_t at_game_seconds = 0; // as requested
+    int64_t tick = 0;            // tick it fired on (first tick at or after at_game_seconds)
+    EventKind kind = 0;
+    uint64_t payload = 0;        // e.g. a construction project or ship id
+};
+
+using EventHandler = std::function<void(const ScheduledEvent&)>;
+
+// "Fire at game second T" events (construction completions, ship
+// arrivals, contract expiries, decay), driven by the clock's fixed ticks.
+//
+// Hierarchical timing wheel: four levels of 256 slots, one tick per slot at
+// level 0 and 256x coarser per level above, so inserting and
+// cancelling are O(1) list splices and each tick touches one level-0 slot
+// plus, every 256^k ticks, one slot cascading down from level k. Events
+// are nodes in a pool with intrusive links (no allocation per event once
+// the pool has grown) and carry a kind + payload instead of a closure;
+// handlers are registered per kind.
+//
+// Thread-safe: events may be scheduled or cancelled from any thread,
+// including from handlers. Handlers run on the advancing thread without
+// the lock held.
+class EventScheduler {
+public:
+    explicit EventScheduler(int64_t tick_step_game_seconds)
+        : step_(tick_step_game_seconds > 0 ? tick_step_game_seconds : 1) {
+        heads_.fill(kNil);
+    }
+
+    // Register every kind before the first advance_to().
+    EventKind add_kind(std::string name, EventHandler handler);
+
+    // Fires on the first tick at or after `at_game_seconds`; a time already
+    // passed fires on the next tick. Invalid handle for an unknown kind.
+    EventHandle schedule_at(int64_t at_game_seconds, EventKind kind, uint64_t payload = 0);
+
+    // False if the event already fired or was cancelled.
+    bool cancel(EventHandle h);
+    bool pending(EventHandle h) const;
+
+    // Fires everything due up to and including `tick`, in tick order, then
+    // by scheduling order within a tick. Called once per clock tick.
+    void advance_to(int64_t tick);
+
+    int64_t current_tick() const;
+    size_t pending_count() const;
+    uint64_t fired_count() const;
+
+private:
+    static constexpr uint32_t kNil = UINT32_MAX;
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr uint32_t kOverflow = kLevels * kSlots; // beyond the top level's range
+    static constexpr uint32_t kFiring = kOverflow + 1;      // taken off the wheel, handler not run yet
+
+    struct Node {
+        int64_t due = 0; // tick
+        int64_t at_game_seconds = 0;
+        uint64_t payload = 0;
+        uint64_t seq = 0; // scheduling order, breaks ties within a tick
+        uint32_t prev = kNil, next = kNil;
+        uint32_t slot = kNil; // kNil while free
+        uint32_t generation = 0;
+        EventKind kind = 0;
+    };
+
+    int64_t step_;
+    mutable std::mutex mu_;
+    int64_t now_ = 0; // last tick processed
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> free_;
+    std::array<uint32_t, kOverflow + 1> heads_; // doubly linked slot lists
+    uint64_t next_seq_ = 0;
+    std::vector<std::pair<std::string, EventHandler>> kinds_;
+    size_t pending_ = 0;
+    uint64_t fired_ = 0;
+
+    // All need mu_.
+    void place(uint32_t n);
+    void link(uint32_t n, uint32_t slot);
+    void unlink(uint32_t n);
+    void release(uint32_t n);
+    void cascade(uint32_t slot);
+};
+
+} // namespace sim
@@ -1,20 +1,45 @@
 #pragma once
 #include <cstdint>
 #include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
 
 #include "time/game_time.h"
+#include "util/seqlock.h"
 
 namespace sim {
 
+// What readers see of the clock, published as one consistent value.
+struct ClockSnapshot {
+    int64_t game_seconds = 0;
+    int64_t tick_count = 0;
+    char gst[32] = {}; // format_gst_datetime of game_seconds, NUL-terminated
+
+    std::string_view gst_view() const { return gst; }
+};
+
+// update(), next_tick_deadline() and set_tick_handler() belong to the tick
+// thread. The readers (snapshot(), now_*, tick_count()) are safe from any
+// thread: they copy a seqlock-published snapshot, never lock and never
+// hold up the tick thread.
 class GameClock {
 public:
     explicit GameClock(time_sim::GameTimeConfig cfg)
         : cfg_(cfg),
-          last_real_(std::chrono::steady_clock::now()) {}
+          last_real_(std::chrono::steady_clock::now()) {
+        publish();
+    }
 
     // Call this frequently (each loop iteration)
-    // Advances game time deterministically using fixed tick steps.
-    void update() {
+    // Advances game time deterministically using fixed tick steps, at most
+    // max_ticks of them; ticks beyond that stay due for the next call.
+    // Returns the number of ticks stepped.
+    int update(int max_ticks = std::numeric_limits<int>::max()) {
         using namespace std::chrono;
         auto now = steady_clock::now();
         duration<double> real_dt = now - last_real_;
@@ -32,19 +57,39 @@ public:
         }
 
         // Step the sim in fixed-size game ticks
-        while (tick_debt_ + cfg_.tick_step_game_seconds <= game_seconds_) {
+        int stepped = 0;
+        while (stepped < max_ticks && tick_debt_ + cfg_.tick_step_game_seconds <= game_seconds_) {
             tick_debt_ += cfg_.tick_step_game_seconds;
             ++tick_count_;
-            // TODO: call sim step here later (industry, AI, etc.)
+            ++stepped;
+            if (on_tick_) on_tick_(tick_count_, tick_debt_);
         }
+        publish();
+        return stepped;
+    }
+
+    // Real time at which the next tick becomes due (in the past when
+    // update() left ticks pending).
+    std::chrono::steady_clock::time_point next_tick_deadline() const {
+        using namespace std::chrono;
+        double game_left = static_cast<double>(tick_debt_ + cfg_.tick_step_game_seconds) -
+                           (static_cast<double>(game_seconds_) + game_accum_);
+        auto real_left = duration_cast<steady_clock::duration>(
+            duration<double>(game_left / cfg_.game_seconds_per_real_second));
+        return last_real_ + real_left + microseconds(1); // round up past the due instant
     }
 
-    int64_t now_game_seconds() const { return game_seconds_; }
-    int64_t tick_count() const { return tick_count_; }
+    // Called from update() once per fixed tick with (tick number, game
+    // seconds at that tick), e.g. TickScheduler::run_tick. Set before ticking.
+    void set_tick_handler(std::function<void(int64_t, int64_t)> fn) { on_tick_ = std::move(fn); }
+
+    ClockSnapshot snapshot() const { return published_.load(); }
+    int64_t now_game_seconds() const { return snapshot().game_seconds; }
+    int64_t tick_count() const { return snapshot().tick_count; }
     const time_sim::GameTimeConfig& cfg() const { return cfg_; }
 
     std::string now_gst() const {
-        return time_sim::format_gst_datetime(cfg_, game_seconds_);
+        return std::string(snapshot().gst_view());
     }
 
 private:
@@ -56,6 +101,27 @@ private:
 
     int64_t tick_debt_  = 0;   // how far we have stepped deterministic sim
     int64_t tick_count_ = 0;
+
+    std::function<void(int64_t, int64_t)> on_tick_;
+
+    // GST text only changes once a game minute, so it is formatted then
+    // and reused in between.
+    int64_t gst_minute_ = -1;
+    ClockSnapshot next_;
+    util::SeqLock<ClockSnapshot> published_;
+
+    void publish() {
+        next_.game_seconds = game_seconds_;
+        next_.tick_count = tick_count_;
+        if (game_seconds_ / 60 != gst_minute_) {
+            gst_minute_ = game_seconds_ / 60;
+            std::string gst = time_sim::format_gst_datetime(cfg_, game_seconds_);
+            size_t n = std::min(gst.size(), sizeof(next_.gst) - 1);
+            std::memcpy(next_.gst, gst.data(), n);
+            next_.gst[n] = '\0';
+        }
+        published_.store(next_);
+    }
 };
 
 } // namespace sim
@@ -0,0 +1,83 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "util/work_stealing_pool.h"
+
+namespace sim {
+
+// Where a per-system update leaves effects on other systems (a ship
+// entering a gate, a trade shipment) instead of writing them directly.
+template <class Msg>
+class PhaseOutbox {
+public:
+    void send(Msg m) { buf_->push_back(std::move(m)); }
+
+private:
+    template <class> friend class ParallelPhaseRunner;
+    explicit PhaseOutbox(std::vector<Msg>* buf) : buf_(buf) {}
+    std::vector<Msg>* buf_;
+};
+
+// Runs a per-system update over dense system indices on a work-stealing
+// pool. Updates may only write their own system's state; cross-system
+// effects go to a PhaseOutbox. Each participant appends to its own buffer
+// and records which chunk each run of messages came from; run() then
+// concatenates the runs in chunk order. Chunk boundaries depend only on
+// the grain, so the merged list is in (system index, send order) whatever
+// the thread count or stealing pattern, and the caller applies it serially.
+template <class Msg>
+class ParallelPhaseRunner {
+public:
+    explicit ParallelPhaseRunner(util::WorkStealingPool& pool, size_t grain = 64)
+        : pool_(&pool), grain_(std::max<size_t>(grain, 1)), buffers_(pool.participants()) {}
+
+    // update(index, outbox) for every index in [0, count). The returned
+    // messages stay valid until the next run().
+    template <class Fn>
+    const std::vector<Msg>& run(size_t count, Fn&& update) {
+        for (auto& b : buffers_) {
+            b.msgs.clear();
+            b.runs.clear();
+        }
+        pool_->run(count, grain_, [&](size_t begin, size_t end, unsigned who) {
+            Buffer& b = buffers_[who];
+            size_t first = b.msgs.size();
+            PhaseOutbox<Msg> out(&b.msgs);
+            for (size_t i = begin; i < end; ++i) update(static_cast<uint32_t>(i), out);
+            if (b.msgs.size() > first) b.runs.push_back({begin / grain_, who, first, b.msgs.size()});
+        });
+
+        std::vector<Run> runs;
+        for (const auto& b : buffers_) runs.insert(runs.end(), b.runs.begin(), b.runs.end());
+        std::sort(runs.begin(), runs.end(), [](const Run& a, const Run& b) { return a.chunk < b.chunk; });
+        merged_.clear();
+        for (const Run& r : runs) {
+            auto& src = buffers_[r.who].msgs;
+            merged_.insert(merged_.end(), std::make_move_iterator(src.begin() + static_cast<std::ptrdiff_t>(r.begin)),
+                           std::make_move_iterator(src.begin() + static_cast<std::ptrdiff_t>(r.end)));
+        }
+        return merged_;
+    }
+
+private:
+    struct Run {
+        size_t chunk;
+        unsigned who;
+        size_t begin, end; // within buffers_[who].msgs
+    };
+    struct alignas(64) Buffer { // own cache line: participants append concurrently
+        std::vector<Msg> msgs;
+        std::vector<Run> runs;
+    };
+
+    util::WorkStealingPool* pool_;
+    size_t grain_;
+    std::vector<Buffer> buffers_; // one per pool participant, reused every run
+    std::vector<Msg> merged_;
+};
+
+} // namespace sim
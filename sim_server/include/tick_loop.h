@@ -0,0 +1,60 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+namespace sim {
+
+class GameClock;
+
+struct TickLoopOptions {
+    // Catch-up bound: after a stall, at most this many ticks run per wakeup
+    // before the loop re-reads the clock.
+    int max_ticks_per_wakeup = 8;
+    // Longest sleep between clock updates even with no tick due, so the
+    // displayed game time keeps moving between ticks.
+    std::chrono::milliseconds max_sleep{1000};
+};
+
+struct TickLoopStats {
+    uint64_t wakeups = 0;
+    uint64_t ticks = 0;
+    uint64_t tick_wakeups = 0;   // wakeups that ran at least one tick
+    uint64_t capped_wakeups = 0; // hit max_ticks_per_wakeup with more ticks due
+    uint64_t overruns = 0;       // tick wakeups that ended past the next deadline
+    double last_lag_ms = 0;      // real start of the tick wakeup minus its deadline
+    double max_lag_ms = 0;
+    double total_lag_ms = 0;
+};
+
+// Drives a GameClock from its own thread, sleeping until the next tick's
+// real-time deadline instead of polling. stop() wakes the sleeper at once
+// and joins. The clock must outlive the loop.
+class TickLoop {
+public:
+    explicit TickLoop(GameClock& clock, TickLoopOptions opts = {}) : clock_(&clock), opts_(opts) {}
+    ~TickLoop() { stop(); }
+
+    TickLoop(const TickLoop&) = delete;
+    TickLoop& operator=(const TickLoop&) = delete;
+
+    void start();
+    void stop();
+
+    TickLoopStats stats() const;
+
+private:
+    void run(std::stop_token stop);
+
+    GameClock* clock_;
+    TickLoopOptions opts_;
+
+    mutable std::mutex mu_; // guards stats_; also the sleep's wait
+    std::condition_variable_any wake_;
+    TickLoopStats stats_;
+    std::jthread thread_;
+};
+
+} // namespace sim
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+// What a phase sees when it runs. A phase split into slices runs one slice
+// per call and should only touch its share of the work (e.g. factions with
+// id % slices == slice); together the slices cover one full period.
+struct TickContext {
+    int64_t tick = 0;          // clock tick being stepped
+    int64_t game_seconds = 0;  // game time at that tick
+    int64_t dt_game_seconds = 0; // the phase's period: time since this slice last ran
+    uint32_t slice = 0;
+    uint32_t slices = 1;
+};
+
+using PhaseFn = std::function<void(const TickContext&)>;
+
+struct PhaseOptions {
+    std::string name;
+    int64_t period_game_seconds = 0; // rounded up to whole ticks, at least one
+    int priority = 0;                // higher runs first within a tick
+    uint32_t slices = 1;             // spread each period's work over this many ticks
+};
+
+struct PhaseStats {
+    std::string name;
+    int64_t period_ticks = 0;
+    int64_t offset_ticks = 0;
+    uint32_t slices = 1;
+    int priority = 0;
+    uint64_t runs = 0;
+    double total_ms = 0;
+    double max_ms = 0;
+};
+
+// Multi-rate driver for the simulation layers (fast: movement and combat,
+// medium: production and trade, slow: strategy and diplomacy). Each tick
+// runs the phases that are due, by priority then registration order, so a
+// given tick always runs the same phases in the same order.
+//
+// Phases sharing a period would otherwise all land on the same tick: each
+// new phase gets the offset within its period that overlaps least with
+// the phases registered before it, and a sliced phase's slices are spaced
+// evenly through the period.
+class TickScheduler {
+public:
+    explicit TickScheduler(int64_t tick_step_game_seconds)
+        : step_(tick_step_game_seconds > 0 ? tick_step_game_seconds : 1) {}
+
+    // Register before the clock starts ticking. Returns the phase id, or -1
+    // if the options are invalid (no callback, slices == 0 or more slices
+    // than ticks in the period).
+    int add_phase(const PhaseOptions& opts, PhaseFn fn);
+
+    // Runs every phase due at `tick`. Called by the clock once per tick.
+    void run_tick(int64_t tick, int64_t game_seconds);
+
+    size_t phase_count() const { return phases_.size(); }
+    std::vector<PhaseStats> stats() const;
+
+private:
+    struct Phase {
+        int id = 0;
+        PhaseOptions opts;
+        PhaseFn fn;
+        int64_t period = 1; // ticks
+        int64_t offset = 0; // ticks
+        uint64_t runs = 0;
+        double total_ms = 0;
+        double max_ms = 0;
+    };
+
+    // Slice of `p` due at `tick`, or -1.
+    static int64_t due_slice(const Phase& p, int64_t tick);
+
+    int64_t step_;
+    std::vector<Phase> phases_; // run order: priority desc, then id
+    mutable std::mutex stats_mu_;
+};
+
+} // namespace sim
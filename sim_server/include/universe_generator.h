@@ -5,8 +5,24 @@
 
 namespace sim {
 
+// How gates are laid out. Systems always get positions on a galactic disk.
+//  Random:  a random spanning tree (<= 4 gates per system) plus 15-25% extra
+//           links (<= 6 gates), biased towards well-connected systems and
+//           systems far apart in the tree. Gates ignore geometry.
+//  Spatial: gates only join near neighbours: a shortest-first spanning tree
+//           over each system's nearest systems, plus the 15-25% local gates
+//           that save the most jumps.
+enum class GateLayout : uint8_t { Random, Spatial };
+
+struct GeneratorOptions {
+    unsigned threads = 0; // 0 = hardware concurrency; also used by freeze()
+    GateLayout layout = GateLayout::Random;
+};
+
 // Generates a connected universe with N systems and a gate network.
-// Deterministic for a given seed.
-universe::Universe generate_universe(int system_count, uint32_t seed);
+// O(N) (O(N log N) sorting candidate gates in the spatial layout). Draws
+// come from a counter-based RNG keyed by seed and system, so the output is
+// bit-identical for a given seed whatever the thread count.
+universe::Universe generate_universe(int system_count, uint32_t seed, const GeneratorOptions& opts = {});
 
 }
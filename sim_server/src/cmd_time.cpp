@@ -4,6 +4,8 @@
 
 #include "commands/commands.h"   // core command types
 #include "game_clock.h"          // sim_server clock
+#include "tick_loop.h"
+#include "tick_scheduler.h"
 #include "time/game_time.h"      // core formatting
 
 namespace sim_cmd {
@@ -14,14 +16,53 @@ void register_time_commands(commands::Router& r, const sim::GameClock& clock) {
             return {false, "Usage: time", "usage", {}};
         }
 
+        auto now = clock.snapshot();
         std::ostringstream out;
-        out << "Time: " << clock.now_gst() << "\n";
-        out << "GameSeconds: " << clock.now_game_seconds() << "\n";
-        out << "Ticks: " << clock.tick_count() << "\n";
+        out << "Time: " << now.gst_view() << "\n";
+        out << "GameSeconds: " << now.game_seconds << "\n";
+        out << "Ticks: " << now.tick_count << "\n";
         out << "Scale: " << clock.cfg().game_seconds_per_real_second << " game sec / real sec\n";
         out << "TickStep: " << clock.cfg().tick_step_game_seconds << " game sec\n";
         return {true, out.str(), "", {}};
     });
 }
 
+void register_phase_commands(commands::Router& r, const sim::TickScheduler& scheduler) {
+    r.add("phases", [&scheduler](const commands::Context&, const commands::Command& cmd) -> commands::Result {
+        if (!cmd.args.empty()) {
+            return {false, "Usage: phases", "usage", {}};
+        }
+
+        std::ostringstream out;
+        out << "Phases (run order):\n";
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        for (const auto& p : scheduler.stats()) {
+            out << "  - " << p.name << ": every " << p.period_ticks << " ticks (offset " << p.offset_ticks;
+            if (p.slices > 1) out << ", " << p.slices << " slices";
+            out << "), priority " << p.priority << ", runs " << p.runs;
+            out << ", avg " << (p.runs ? p.total_ms / static_cast<double>(p.runs) : 0.0) << " ms, max " << p.max_ms << " ms\n";
+        }
+        return {true, out.str(), "", {}};
+    });
+}
+
+void register_tick_loop_commands(commands::Router& r, const sim::TickLoop& loop) {
+    r.add("ticklag", [&loop](const commands::Context&, const commands::Command& cmd) -> commands::Result {
+        if (!cmd.args.empty()) {
+            return {false, "Usage: ticklag", "usage", {}};
+        }
+
+        auto st = loop.stats();
+        std::ostringstream out;
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        out << "Ticks: " << st.ticks << " over " << st.tick_wakeups << " wakeups (" << st.wakeups << " total)\n";
+        out << "Lag: last " << st.last_lag_ms << " ms, max " << st.max_lag_ms << " ms, avg "
+            << (st.tick_wakeups ? st.total_lag_ms / static_cast<double>(st.tick_wakeups) : 0.0) << " ms\n";
+        out << "Overruns: " << st.overruns << " (catch-up capped " << st.capped_wakeups << " times)\n";
+        return {true, out.str(), "", {}};
+    });
+}
+
 } // namespace sim_cmd
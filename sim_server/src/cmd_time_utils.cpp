@@ -48,10 +48,11 @@ void register_time_utils(commands::Router& r, const sim::GameClock& clock) {
             return {false, "Invalid seconds value.", "bad_input", {}};
         }
 
-        int64_t future = clock.now_game_seconds() + secs;
+        auto now = clock.snapshot();
+        int64_t future = now.game_seconds + secs;
 
         std::ostringstream out;
-        out << "Now:  " << clock.now_gst() << "\n";
+        out << "Now:  " << now.gst_view() << "\n";
         out << "Then: " << time_sim::format_gst_datetime(clock.cfg(), future) << "\n";
         out << "In:   " << time_sim::format_duration(secs);
 
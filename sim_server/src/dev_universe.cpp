@@ -5,11 +5,17 @@ namespace sim {
 universe::Universe build_dev_universe() {
     universe::Universe u;
 
-    // systems
-    u.add_system({1, "sol"});
-    u.add_system({2, "vega"});
-    u.add_system({3, "eos"});
-    u.add_system({4, "kelnor"});
+    // systems (positions in light-years)
+    auto add = [&u](universe::SystemId id, const char* name, universe::Vec3 pos) {
+        universe::SolarSystem s{id, name};
+        s.position = pos;
+        u.add_system(std::move(s));
+    };
+    add(1, "sol", {0.0f, 0.0f, 0.0f});
+    add(2, "vega", {9.2f, 3.1f, -1.5f});
+    add(3, "eos", {14.8f, -6.0f, 2.2f});
+    add(4, "kelnor", {27.5f, -2.4f, 0.8f});
+    u.build_spatial_index();
 
     // gates (sol->vega->eos->kelnor)
     u.gates().add_gate(1, 2);
@@ -19,6 +25,8 @@ universe::Universe build_dev_universe() {
     // a shortcut to make routes interesting (sol->eos)
     u.gates().add_gate(1, 3);
 
+    u.gates().freeze();
+
     return u;
 }
 
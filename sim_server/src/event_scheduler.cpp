@@ -0,0 +1,165 @@
+#include "event_scheduler.h"
+
+#include <algorithm>
+
+namespace sim {
+
+EventKind EventScheduler::add_kind(std::string name, EventHandler handler) {
+    std::lock_guard lock(mu_);
+    kinds_.emplace_back(std::move(name), std::move(handler));
+    return static_cast<EventKind>(kinds_.size() - 1);
+}
+
+void EventScheduler::link(uint32_t n, uint32_t slot) {
+    Node& node = nodes_[n];
+    node.slot = slot;
+    node.prev = kNil;
+    node.next = heads_[slot];
+    if (node.next != kNil) nodes_[node.next].prev = n;
+    heads_[slot] = n;
+}
+
+void EventScheduler::unlink(uint32_t n) {
+    Node& node = nodes_[n];
+    if (node.prev != kNil) nodes_[node.prev].next = node.next;
+    else heads_[node.slot] = node.next;
+    if (node.next != kNil) nodes_[node.next].prev = node.prev;
+    node.prev = node.next = kNil;
+}
+
+void EventScheduler::release(uint32_t n) {
+    Node& node = nodes_[n];
+    node.slot = kNil;
+    ++node.generation;
+    free_.push_back(n);
+    --pending_;
+}
+
+// Level L holds events due within 256^(L+1) ticks, in the slot of their
+// due tick's L-th byte. Such an event is cascaded one level down when the
+// clock reaches its due tick with the lower L bytes cleared, which always
+// lies after now_ and before the slot comes round again.
+void EventScheduler::place(uint32_t n) {
+    const int64_t due = nodes_[n].due;
+    const auto delta = static_cast<uint64_t>(due - now_);
+    for (int level = 0; level < kLevels; ++level) {
+        const int shift = kSlotBits * level;
+        if (delta < (uint64_t{1} << (shift + kSlotBits))) {
+            link(n, static_cast<uint32_t>(level) * kSlots + static_cast<uint32_t>((due >> shift) & (kSlots - 1)));
+            return;
+        }
+    }
+    link(n, kOverflow);
+}
+
+void EventScheduler::cascade(uint32_t slot) {
+    uint32_t n = heads_[slot];
+    heads_[slot] = kNil;
+    while (n != kNil) {
+        uint32_t next = nodes_[n].next;
+        place(n);
+        n = next;
+    }
+}
+
+EventHandle EventScheduler::schedule_at(int64_t at_game_seconds, EventKind kind, uint64_t payload) {
+    std::lock_guard lock(mu_);
+    if (kind >= kinds_.size()) return {};
+
+    uint32_t n;
+    if (!free_.empty()) {
+        n = free_.back();
+        free_.pop_back();
+    } else {
+        n = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+    Node& node = nodes_[n];
+    // First tick at or after the requested time, never the tick already run.
+    int64_t due = at_game_seconds > 0 ? (at_game_seconds + step_ - 1) / step_ : 0;
+    node.due = std::max(due, now_ + 1);
+    node.at_game_seconds = at_game_seconds;
+    node.payload = payload;
+    node.seq = next_seq_++;
+    node.kind = kind;
+    ++pending_;
+    place(n);
+    return {n, node.generation};
+}
+
+bool EventScheduler::cancel(EventHandle h) {
+    std::lock_guard lock(mu_);
+    if (h.index >= nodes_.size()) return false;
+    Node& node = nodes_[h.index];
+    if (node.generation != h.generation || node.slot == kNil) return false;
+    if (node.slot != kFiring) unlink(h.index);
+    release(h.index);
+    return true;
+}
+
+bool EventScheduler::pending(EventHandle h) const {
+    std::lock_guard lock(mu_);
+    return h.index < nodes_.size() && nodes_[h.index].generation == h.generation && nodes_[h.index].slot != kNil;
+}
+
+void EventScheduler::advance_to(int64_t tick) {
+    std::vector<std::pair<uint64_t, uint32_t>> batch; // (seq, node)
+    std::unique_lock lock(mu_);
+    while (now_ < tick) {
+        if (pending_ == 0) {
+            now_ = tick; // nothing on the wheel: slots are relative to no one
+            break;
+        }
+        ++now_;
+
+        // Cascade from the top so events falling through several levels
+        // land in this tick's slot.
+        constexpr int64_t kTopSpan = int64_t{1} << (kSlotBits * kLevels);
+        if ((now_ & (kTopSpan - 1)) == 0) cascade(kOverflow);
+        for (int level = kLevels - 1; level >= 1; --level) {
+            const int shift = kSlotBits * level;
+            if ((now_ & ((int64_t{1} << shift) - 1)) != 0) continue;
+            cascade(static_cast<uint32_t>(level) * kSlots + static_cast<uint32_t>((now_ >> shift) & (kSlots - 1)));
+        }
+
+        const auto slot = static_cast<uint32_t>(now_ & (kSlots - 1));
+        batch.clear();
+        for (uint32_t n = heads_[slot]; n != kNil; n = nodes_[n].next) {
+            nodes_[n].slot = kFiring;
+            batch.emplace_back(nodes_[n].seq, n);
+        }
+        heads_[slot] = kNil;
+        std::sort(batch.begin(), batch.end());
+
+        for (const auto& [seq, n] : batch) {
+            Node& node = nodes_[n];
+            if (node.slot != kFiring || node.seq != seq) continue; // cancelled by an earlier handler
+            node.prev = node.next = kNil;
+            ScheduledEvent ev{{n, node.generation}, node.at_game_seconds, now_, node.kind, node.payload};
+            const EventHandler* handler = &kinds_[node.kind].second;
+            release(n);
+            ++fired_;
+
+            lock.unlock();
+            if (*handler) (*handler)(ev);
+            lock.lock();
+        }
+    }
+}
+
+int64_t EventScheduler::current_tick() const {
+    std::lock_guard lock(mu_);
+    return now_;
+}
+
+size_t EventScheduler::pending_count() const {
+    std::lock_guard lock(mu_);
+    return pending_;
+}
+
+uint64_t EventScheduler::fired_count() const {
+    std::lock_guard lock(mu_);
+    return fired_;
+}
+
+} // namespace sim
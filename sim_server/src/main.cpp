@@ -1,12 +1,18 @@
+#include <csignal>
 #include <cstdlib>
 #include <iostream>
 #include <string>
 #include <thread>
 #include <chrono>
 
+#include <pthread.h>
+
 #include "httplib.h"
 
 #include "game_clock.h"
+#include "tick_scheduler.h"
+#include "event_scheduler.h"
+#include "tick_loop.h"
 #include "cmd_time.h"
 #include "cmd_time_utils.h"
 
@@ -16,6 +22,8 @@
 #include "commands/commands.h"
 #include "commands/cmd_universe.h"
 #include "commands/cmd_misc.h"
+#include "universe/sim_state.h"
+#include "universe/snapshot.h"
 
 #ifndef SPACE_SIM_INTERNAL_KEY_DEFAULT
 #define SPACE_SIM_INTERNAL_KEY_DEFAULT "dev123"
@@ -26,9 +34,30 @@ static std::string env_str(const char* k, const char* fallback) {
     return std::string(fallback);
 }
 
-int main() {
+int main(int argc, char** argv) {
     std::cout << "sim_server starting...\n";
 
+    // SIGINT/SIGTERM are taken by a watcher thread (below) rather than a
+    // handler, so shutdown runs as ordinary code. Block them before any
+    // thread starts; threads inherit the mask.
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+    // --load-universe <file>: start from a snapshot instead of generating.
+    // --save-universe <file>: write the universe out once it is ready.
+    // --spatial: generate with gates between nearby systems only.
+    std::string load_path, save_path;
+    sim::GeneratorOptions gen_opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--load-universe" && i + 1 < argc) load_path = argv[++i];
+        else if (a == "--save-universe" && i + 1 < argc) save_path = argv[++i];
+        else if (a == "--spatial") gen_opts.layout = sim::GateLayout::Spatial;
+    }
+
     const std::string internal_key =
         env_str("SPACE_SIM_INTERNAL_KEY", SPACE_SIM_INTERNAL_KEY_DEFAULT);
 
@@ -43,29 +72,90 @@ int main() {
     sim::GameClock clock(tcfg);
 
     // Universe
-    universe::Universe u = sim::generate_universe(500, 1337);
+    auto t0 = std::chrono::steady_clock::now();
+    universe::Universe u;
+    if (!load_path.empty()) {
+        std::string err;
+        auto loaded = universe::load_snapshot(load_path, {}, &err);
+        if (!loaded) {
+            std::cerr << "cannot load universe from " << load_path << ": " << err << "\n";
+            return 1;
+        }
+        u = std::move(*loaded);
+    } else {
+        u = sim::generate_universe(500, 1337, gen_opts);
+    }
+    auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    std::cout << "universe: " << u.system_count() << " systems, " << u.gates().gate_count() << " gates ("
+              << (load_path.empty() ? "generated" : "loaded") << " in " << ms << " ms)\n";
+
+    if (!save_path.empty()) {
+        std::string err;
+        if (!universe::save_snapshot(u, save_path, &err)) {
+            std::cerr << "cannot save universe to " << save_path << ": " << err << "\n";
+            return 1;
+        }
+        std::cout << "universe saved to " << save_path << "\n";
+    }
+
+    // Simulation state: the tick writes the next state while commands read
+    // the last published one.
+    universe::SimStateStore sim_state(universe::SimState::from_universe(u));
+
+    // Simulation layers. Nothing is simulated yet; the phases fix the
+    // cadence each layer runs at.
+    sim::TickScheduler scheduler(tcfg.tick_step_game_seconds);
+    scheduler.add_phase({"fast", tcfg.tick_step_game_seconds, 30, 1}, [](const sim::TickContext&) {
+        // ship movement, local combat, piracy encounters
+    });
+    scheduler.add_phase({"medium", time_sim::hours_to_seconds(1), 20, 1}, [](const sim::TickContext&) {
+        // production, mining, station activity, trade flow
+    });
+    scheduler.add_phase({"slow", time_sim::days_to_seconds(1), 10, 12}, [](const sim::TickContext&) {
+        // faction strategy, diplomacy, war, population; one slice of factions per run
+    });
+
+    // Timed events (construction, arrivals, expiries) fire before the
+    // layers run on their tick; the tick's state is published after both.
+    sim::EventScheduler events(tcfg.tick_step_game_seconds);
+    clock.set_tick_handler([&](int64_t tick, int64_t game_seconds) {
+        sim_state.begin_tick(tick, game_seconds);
+        events.advance_to(tick);
+        scheduler.run_tick(tick, game_seconds);
+        sim_state.publish();
+    });
 
     // Commands
     commands::Router router;
-    commands::register_universe_commands(router, u);
+    commands::register_universe_commands(router, u, &sim_state);
     commands::register_misc_commands(router, u);
     sim_cmd::register_time_commands(router, clock);
     sim_cmd::register_time_utils(router, clock);
+    sim_cmd::register_phase_commands(router, scheduler);
 
-    // Tick thread (dev-simple; we’ll add clean shutdown later)
-    std::thread([&] {
-        while (true) {
-            clock.update();
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        }
-    }).detach();
+    // Tick thread: sleeps until each tick is due.
+    sim::TickLoop tick_loop(clock);
+    sim_cmd::register_tick_loop_commands(router, tick_loop);
+    tick_loop.start();
 
     // Internal API server
     httplib::Server server;
     sim::register_internal_cmd_api(server, internal_key, router);
 
-    std::cout << "sim_server listening on 127.0.0.1:8090\n";
-    server.listen("127.0.0.1", 8090);
+    std::thread signal_watcher([&] {
+        int sig = 0;
+        sigwait(&stop_signals, &sig);
+        server.stop();
+    });
 
-    return 0;
+    std::cout << "sim_server listening on 127.0.0.1:8090\n";
+    bool listened = server.listen("127.0.0.1", 8090);
+
+    // Stopped by a signal, or the listen failed: release the watcher (a
+    // no-op if it already returned) and stop ticking.
+    pthread_kill(signal_watcher.native_handle(), SIGTERM);
+    signal_watcher.join();
+    tick_loop.stop();
+    std::cout << "sim_server stopped\n";
+    return listened ? 0 : 1;
 }
@@ -0,0 +1,54 @@
+#include "tick_loop.h"
+#include "game_clock.h"
+
+#include <algorithm>
+
+namespace sim {
+
+void TickLoop::start() {
+    if (thread_.joinable()) return;
+    thread_ = std::jthread([this](std::stop_token st) { run(st); });
+}
+
+void TickLoop::stop() {
+    if (!thread_.joinable()) return;
+    thread_.request_stop(); // wakes wait_until through the stop token
+    thread_.join();
+}
+
+TickLoopStats TickLoop::stats() const {
+    std::lock_guard lock(mu_);
+    return stats_;
+}
+
+void TickLoop::run(std::stop_token stop) {
+    using Clock = std::chrono::steady_clock;
+    using Ms = std::chrono::duration<double, std::milli>;
+
+    while (!stop.stop_requested()) {
+        const auto deadline = clock_->next_tick_deadline();
+        {
+            std::unique_lock lock(mu_);
+            auto wake_at = std::min(deadline, Clock::now() + opts_.max_sleep);
+            if (wake_.wait_until(lock, stop, wake_at, [] { return false; }) || stop.stop_requested()) break;
+        }
+
+        const auto woke = Clock::now();
+        const int ran = clock_->update(opts_.max_ticks_per_wakeup);
+        const auto next = clock_->next_tick_deadline();
+
+        std::lock_guard lock(mu_);
+        ++stats_.wakeups;
+        if (ran == 0) continue;
+        double lag = std::max(0.0, Ms(woke - deadline).count());
+        ++stats_.tick_wakeups;
+        stats_.ticks += static_cast<uint64_t>(ran);
+        stats_.last_lag_ms = lag;
+        stats_.max_lag_ms = std::max(stats_.max_lag_ms, lag);
+        stats_.total_lag_ms += lag;
+        if (ran == opts_.max_ticks_per_wakeup && next <= Clock::now()) ++stats_.capped_wakeups;
+        if (next <= Clock::now()) ++stats_.overruns;
+    }
+}
+
+} // namespace sim
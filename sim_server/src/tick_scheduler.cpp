@@ -0,0 +1,95 @@
+#include "tick_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace sim {
+
+int64_t TickScheduler::due_slice(const Phase& p, int64_t tick) {
+    int64_t r = (tick - p.offset) % p.period;
+    if (r < 0) r += p.period;
+    // Slice k starts at k * period / slices; find the k (if any) landing on r.
+    const auto s = static_cast<int64_t>(p.opts.slices);
+    int64_t k = (r * s + p.period - 1) / p.period;
+    return k < s && k * p.period / s == r ? k : -1;
+}
+
+int TickScheduler::add_phase(const PhaseOptions& opts, PhaseFn fn) {
+    if (!fn || opts.slices == 0) return -1;
+
+    Phase p;
+    p.id = static_cast<int>(phases_.size());
+    p.opts = opts;
+    p.fn = std::move(fn);
+    p.period = std::max<int64_t>(1, (opts.period_game_seconds + step_ - 1) / step_);
+    if (static_cast<int64_t>(opts.slices) > p.period) return -1;
+
+    // Pick the offset (within one slice spacing) whose runs collide with the
+    // fewest existing runs over one period; ties go to the earliest offset.
+    // busy[t] counts the existing runs at tick t, stepped run by run, so the
+    // search is linear in the period rather than period x offsets x phases.
+    std::vector<int64_t> busy(static_cast<size_t>(p.period), 0);
+    for (const Phase& q : phases_) {
+        const auto qs = static_cast<int64_t>(q.opts.slices);
+        for (int64_t k = 0; k < qs; ++k) {
+            for (int64_t t = (q.offset + k * q.period / qs) % q.period; t < p.period; t += q.period) {
+                ++busy[static_cast<size_t>(t)];
+            }
+        }
+    }
+    const auto slices = static_cast<int64_t>(opts.slices);
+    const int64_t spacing = p.period / slices;
+    int64_t best_offset = 0, best_load = -1;
+    for (int64_t off = 0; off < spacing && best_load != 0; ++off) {
+        int64_t load = 0; // slice k runs at off + k * period / slices < period
+        for (int64_t k = 0; k < slices; ++k) load += busy[static_cast<size_t>(off + k * p.period / slices)];
+        if (best_load < 0 || load < best_load) {
+            best_load = load;
+            best_offset = off;
+        }
+    }
+    p.offset = best_offset;
+
+    auto pos = std::find_if(phases_.begin(), phases_.end(),
+                            [&](const Phase& q) { return q.opts.priority < p.opts.priority; });
+    std::lock_guard lock(stats_mu_);
+    int id = p.id;
+    phases_.insert(pos, std::move(p));
+    return id;
+}
+
+void TickScheduler::run_tick(int64_t tick, int64_t game_seconds) {
+    using Clock = std::chrono::steady_clock;
+    for (Phase& p : phases_) {
+        int64_t slice = due_slice(p, tick);
+        if (slice < 0) continue;
+
+        TickContext ctx;
+        ctx.tick = tick;
+        ctx.game_seconds = game_seconds;
+        ctx.dt_game_seconds = p.period * step_;
+        ctx.slice = static_cast<uint32_t>(slice);
+        ctx.slices = p.opts.slices;
+
+        auto t0 = Clock::now();
+        p.fn(ctx);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+        std::lock_guard lock(stats_mu_);
+        ++p.runs;
+        p.total_ms += ms;
+        p.max_ms = std::max(p.max_ms, ms);
+    }
+}
+
+std::vector<PhaseStats> TickScheduler::stats() const {
+    std::lock_guard lock(stats_mu_);
+    std::vector<PhaseStats> out;
+    out.reserve(phases_.size());
+    for (const Phase& p : phases_) {
+        out.push_back({p.opts.name, p.period, p.offset, p.opts.slices, p.opts.priority, p.runs, p.total_ms, p.max_ms});
+    }
+    return out;
+}
+
+} // namespace sim
@@ -1,37 +1,407 @@
 #include "universe_generator.h"
 
-#include <random>
 #include <vector>
 #include <algorithm>
-#include <iomanip>
-#include <sstream>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <utility>
+
+#include "util/counter_rng.h"
+#include "util/parallel.h"
 
 using universe::SystemId;
 
 namespace sim {
 
-    static std::string sys_name(int n) {
-        std::ostringstream ss;
-        ss << "sys-" << std::setw(4) << std::setfill('0') << n;
-        return ss.str();
+namespace {
+
+// Gate density targets from docs/stargate_network.md: the backbone keeps
+// systems at <= 4 gates, extra links may grow hubs to 6.
+constexpr uint8_t kTreeMaxGates = 4;
+constexpr uint8_t kMaxGates = 6;
+constexpr int kExtraMinPct = 15;
+constexpr int kExtraMaxPct = 25;
+constexpr int kFarCandidates = 4; // per extra link, keep the one farthest away in the tree
+constexpr int kAttemptsPerLink = 8;
+constexpr size_t kGrain = 4096;
+
+// Galaxy shape: a flat disk with about one system per kSpacingLy^2 of area.
+constexpr float kSpacingLy = 8.0f;
+constexpr float kDiskThicknessLy = 2.0f * kSpacingLy;
+
+// Spatial layout: gate candidates are each system's nearest neighbours;
+// shortcuts must save at least this many jumps over the tree.
+constexpr int kNearest = 5;
+constexpr int kMinShortcutJumps = 3;
+constexpr int kShortcutRankLimit = 64; // geometric trees are deep; rank savings up to here
+
+// One counter-RNG stream per kind of draw; the index within a stream is
+// the system / tree position / link slot the draw belongs to.
+enum Stream : uint32_t { kAttributes = 1, kShuffle, kTree, kPlan, kExtra, kPosition };
+
+// "sys-0042". Zero-padded to at least four digits and to the width of the
+// largest id, so names sort in id order and the name index only appends.
+std::string sys_name(int n, size_t width) {
+    char digits[16];
+    auto end = std::to_chars(digits, digits + sizeof(digits), n).ptr;
+    auto len = static_cast<size_t>(end - digits);
+
+    std::string s = "sys-";
+    if (len < width) s.append(width - len, '0');
+    s.append(digits, len);
+    return s;
+}
+
+size_t digit_count(int n) {
+    size_t d = 1;
+    for (; n >= 10; n /= 10) ++d;
+    return d;
+}
+
+// Random permutation of [0, n) evaluated pointwise: a 4-round Feistel
+// network over the smallest even-width power of two >= n, cycle-walking
+// until the value lands in range (< 4 steps on average).
+class Shuffle {
+public:
+    Shuffle(uint64_t seed, uint32_t n)
+        : n_(n), half_(std::max(1, (static_cast<int>(std::bit_width(n > 0 ? n - 1 : 0u)) + 1) / 2)),
+          mask_((1u << half_) - 1), key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)} {}
+
+    uint32_t operator()(uint32_t i) const {
+        uint32_t x = i;
+        do x = encrypt(x);
+        while (x >= n_);
+        return x;
+    }
+
+private:
+    uint32_t n_;
+    int half_;
+    uint32_t mask_;
+    std::array<uint32_t, 2> key_;
+
+    uint32_t encrypt(uint32_t x) const {
+        uint32_t l = x >> half_, r = x & mask_;
+        for (uint32_t round = 0; round < 4; ++round) {
+            uint32_t f = util::philox4x32({r, round, kShuffle, 0}, key_)[0] & mask_;
+            uint32_t next = l ^ f;
+            l = r;
+            r = next;
+        }
+        return (l << half_) | r;
     }
+};
+
+// Jumps between two nodes along the spanning tree (dense indices), or
+// `limit` if that is closer.
+int tree_distance(const std::vector<int32_t>& parent, const std::vector<int32_t>& depth, int32_t a, int32_t b,
+                  int limit = std::numeric_limits<int>::max()) {
+    int d = 0;
+    while (depth[a] > depth[b] && d < limit) { a = parent[a]; ++d; }
+    while (depth[b] > depth[a] && d < limit) { b = parent[b]; ++d; }
+    while (a != b && d < limit) { a = parent[a]; b = parent[b]; d += 2; }
+    return std::min(d, limit);
+}
+
+// An extra link proposed for one slot: endpoint `a` and up to
+// kFarCandidates partners, farthest (in tree jumps) first; -1 = unused.
+struct LinkProposal {
+    int32_t a = -1;
+    std::array<int32_t, kFarCandidates> b;
+};
+
+struct Parallel {
+    unsigned threads;
+
+    template <class Fn>
+    void operator()(size_t count, Fn&& fn) const { util::parallel_for(count, fn, threads, kGrain); }
+};
 
-universe::Universe generate_universe(int system_count, uint32_t seed) {
+// Adds gates over dense indices (system id = index + 1), tracking degrees.
+struct GateBuilder {
+    universe::GateNetwork& gates;
+    std::vector<uint8_t> degree;
+
+    bool link(int32_t a, int32_t b) {
+        if (!gates.add_gate(a + 1, b + 1)) return false;
+        ++degree[a];
+        ++degree[b];
+        return true;
+    }
+};
+
+size_t extra_link_target(uint64_t seed, size_t tree_links) {
+    util::CounterRng plan(seed, kPlan, 0);
+    auto extra_pct = static_cast<size_t>(plan.between(kExtraMinPct, kExtraMaxPct));
+    return tree_links * extra_pct / 100;
+}
+
+// Random layout: gates ignore geometry.
+void build_random_gates(GateBuilder& gb, size_t n, uint64_t seed, const Parallel& par) {
+    // -----------------------------
+    // Random spanning tree (guaranteed connectivity)
+    // -----------------------------
+    // Systems join in shuffled order; the k-th attaches to a uniformly
+    // random earlier one. If that one already has kTreeMaxGates gates the
+    // next later system with room is used instead. `skip` jumps over full
+    // positions (union-find style, with path halving); the newest system
+    // (position k - 1) has one gate, so the search always ends.
+    std::vector<int32_t> order(n);
+    std::vector<uint32_t> pick(n, 0);
+    const Shuffle shuffle(seed, static_cast<uint32_t>(n));
+    par(n, [&](size_t k) {
+        order[k] = static_cast<int32_t>(shuffle(static_cast<uint32_t>(k)));
+        if (k > 0) pick[k] = util::CounterRng(seed, kTree, k).uniform(static_cast<uint32_t>(k));
+    });
+
+    std::vector<int32_t> parent(n, -1);
+    std::vector<int32_t> depth(n, 0);
+    std::vector<uint32_t> skip(n);
+    for (size_t k = 0; k < n; ++k) skip[k] = static_cast<uint32_t>(k);
+    for (size_t k = 1; k < n; ++k) {
+        uint32_t p = pick[k];
+        while (skip[p] != p) p = skip[p] = skip[skip[p]];
+
+        int32_t v = order[k];
+        int32_t up = order[p];
+        gb.link(up, v);
+        parent[v] = up;
+        depth[v] = depth[up] + 1;
+        if (gb.degree[up] >= kTreeMaxGates) skip[p] = p + 1;
+    }
+
+    // -----------------------------
+    // Extra links (shortcuts, alternate routes)
+    // -----------------------------
+    // One end is an endpoint of a random tree gate, so well-connected
+    // systems are picked in proportion to their degree; the other is the
+    // farthest (in tree jumps) of a few random candidates that still has
+    // room, which cuts the worst distances. Proposals (including the tree
+    // distances, the expensive part) are drawn in parallel per slot, then
+    // applied in slot order under the degree caps. Slots are proposed in
+    // rounds until the target is met or the attempt budget runs out.
+    const size_t tree_links = n - 1;
+    const size_t extra_target = extra_link_target(seed, tree_links);
+    const size_t budget = extra_target * kAttemptsPerLink;
+
+    std::vector<LinkProposal> proposals;
+    size_t added = 0;
+    for (size_t slot = 0; added < extra_target && slot < budget;) {
+        size_t batch = std::min(budget - slot, std::max<size_t>(2 * (extra_target - added), 64));
+        proposals.assign(batch, {});
+        par(batch, [&](size_t i) {
+            util::CounterRng r(seed, kExtra, slot + i);
+            size_t k = 1 + r.uniform(static_cast<uint32_t>(tree_links)); // tree gate order[k] - parent
+            int32_t a = (r.next_u32() & 1) ? order[k] : parent[order[k]];
+
+            std::array<std::pair<int, int32_t>, kFarCandidates> cand;
+            for (auto& c : cand) {
+                auto b = static_cast<int32_t>(r.uniform(static_cast<uint32_t>(n)));
+                c = {b == a ? 0 : tree_distance(parent, depth, a, b), b};
+            }
+            std::sort(cand.begin(), cand.end(), [](const auto& x, const auto& y) { return x.first > y.first; });
+
+            LinkProposal& out = proposals[i];
+            out.a = a;
+            for (int c = 0; c < kFarCandidates; ++c) {
+                out.b[c] = cand[c].first > 1 ? cand[c].second : -1; // tree neighbours are already linked
+            }
+        });
+
+        for (size_t i = 0; i < batch && added < extra_target; ++i) {
+            const LinkProposal& p = proposals[i];
+            if (gb.degree[p.a] >= kMaxGates) continue;
+            for (int32_t b : p.b) {
+                if (b < 0 || gb.degree[b] >= kMaxGates) continue;
+                if (gb.link(p.a, b)) ++added;
+                break;
+            }
+        }
+        slot += batch;
+    }
+}
+
+// Spatial layout: gates only join near neighbours, so the map looks like
+// the galaxy it sits in. Needs u's spatial index.
+void build_spatial_gates(GateBuilder& gb, const universe::Universe& u, uint64_t seed, const Parallel& par) {
+    const size_t n = u.system_count();
+    const universe::SpatialIndex& idx = *u.spatial_index();
+    const auto pos = u.positions();
+
+    // Candidate gates: each system's kNearest neighbours, found in parallel.
+    std::vector<int32_t> near(n * kNearest, -1);
+    par(n, [&](size_t i) {
+        int c = 0;
+        for (const auto& h : idx.nearest(pos[i], kNearest + 1)) {
+            if (h.index != i && c < kNearest) near[i * kNearest + static_cast<size_t>(c++)] = static_cast<int32_t>(h.index);
+        }
+    });
+    auto lists = [&](size_t a, int32_t b) {
+        const int32_t* l = &near[a * kNearest];
+        return std::find(l, l + kNearest, b) != l + kNearest;
+    };
+
+    struct Candidate {
+        float len;
+        int32_t a, b;
+    };
+    std::vector<Candidate> cand;
+    cand.reserve(n * kNearest);
+    for (size_t i = 0; i < n; ++i) {
+        for (int c = 0; c < kNearest; ++c) {
+            int32_t b = near[i * kNearest + static_cast<size_t>(c)];
+            if (b < 0) continue;
+            // Mutual neighbours are listed twice; keep the pair once.
+            if (static_cast<size_t>(b) < i && lists(static_cast<size_t>(b), static_cast<int32_t>(i))) continue;
+            auto a = static_cast<int32_t>(i);
+            cand.push_back({universe::distance(pos[i], pos[static_cast<size_t>(b)]), std::min(a, b), std::max(a, b)});
+        }
+    }
+    std::sort(cand.begin(), cand.end(), [](const Candidate& x, const Candidate& y) {
+        if (x.len != y.len) return x.len < y.len;
+        return x.a != y.a ? x.a < y.a : x.b < y.b;
+    });
+
+    // -----------------------------
+    // Spanning tree: Kruskal over the candidates, shortest first, under the
+    // backbone degree cap. Leftover fragments (sparse corners, caps) are
+    // stitched to the nearest system in another fragment.
+    // -----------------------------
+    std::vector<int32_t> comp(n);
+    for (size_t i = 0; i < n; ++i) comp[i] = static_cast<int32_t>(i);
+    auto find = [&](int32_t x) {
+        while (comp[x] != x) x = comp[x] = comp[comp[x]];
+        return x;
+    };
+
+    std::vector<std::pair<int32_t, int32_t>> tree;
+    tree.reserve(n - 1);
+    std::vector<Candidate> rest; // candidates not in the tree, still in length order
+    for (const Candidate& c : cand) {
+        int32_t ra = find(c.a), rb = find(c.b);
+        if (ra != rb && gb.degree[c.a] < kTreeMaxGates && gb.degree[c.b] < kTreeMaxGates && gb.link(c.a, c.b)) {
+            comp[ra] = rb;
+            tree.emplace_back(c.a, c.b);
+        } else {
+            rest.push_back(c);
+        }
+    }
+
+    while (tree.size() + 1 < n) {
+        for (size_t i = 0; i < n; ++i) {
+            auto a = static_cast<int32_t>(i);
+            if (find(a) != a) continue;
+            for (size_t k = 16;; k *= 4) {
+                auto hits = idx.nearest(pos[i], k);
+                auto it = std::find_if(hits.begin(), hits.end(), [&](const universe::SpatialHit& h) {
+                    return find(static_cast<int32_t>(h.index)) != a;
+                });
+                if (it != hits.end()) {
+                    auto b = static_cast<int32_t>(it->index);
+                    gb.link(a, b);
+                    comp[a] = find(b);
+                    tree.emplace_back(a, b);
+                    break;
+                }
+                if (k >= n) break;
+            }
+        }
+    }
+
+    // Root the tree at system 0 for tree distances.
+    std::vector<int32_t> offsets(n + 1, 0), adj(2 * tree.size());
+    for (auto [a, b] : tree) { ++offsets[a + 1]; ++offsets[b + 1]; }
+    for (size_t i = 0; i < n; ++i) offsets[i + 1] += offsets[i];
+    std::vector<int32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (auto [a, b] : tree) { adj[fill[a]++] = b; adj[fill[b]++] = a; }
+
+    std::vector<int32_t> parent(n, -1), depth(n, 0), queue{0};
+    queue.reserve(n);
+    parent[0] = 0;
+    for (size_t q = 0; q < queue.size(); ++q) {
+        int32_t v = queue[q];
+        for (int32_t k = offsets[v]; k < offsets[v + 1]; ++k) {
+            int32_t w = adj[k];
+            if (parent[w] >= 0) continue;
+            parent[w] = v;
+            depth[w] = depth[v] + 1;
+            queue.push_back(w);
+        }
+    }
+
+    // -----------------------------
+    // Extra links: the unused candidates whose ends are farthest apart in
+    // the tree, i.e. the local gates that save the most jumps (shortest
+    // gate first among those saving kShortcutRankLimit or more).
+    // -----------------------------
+    std::vector<int> saved(rest.size());
+    par(rest.size(), [&](size_t i) {
+        saved[i] = tree_distance(parent, depth, rest[i].a, rest[i].b, kShortcutRankLimit);
+    });
+
+    std::vector<uint32_t> by_gain(rest.size());
+    for (size_t i = 0; i < rest.size(); ++i) by_gain[i] = static_cast<uint32_t>(i);
+    std::sort(by_gain.begin(), by_gain.end(), [&](uint32_t x, uint32_t y) {
+        return saved[x] != saved[y] ? saved[x] > saved[y] : x < y; // shorter gate first
+    });
+
+    const size_t extra_target = extra_link_target(seed, n - 1);
+    size_t added = 0;
+    for (size_t i = 0; i < by_gain.size() && added < extra_target; ++i) {
+        const Candidate& c = rest[by_gain[i]];
+        if (saved[by_gain[i]] < kMinShortcutJumps) break;
+        if (gb.degree[c.a] >= kMaxGates || gb.degree[c.b] >= kMaxGates) continue;
+        if (gb.link(c.a, c.b)) ++added;
+    }
+}
+
+} // namespace
+
+universe::Universe generate_universe(int system_count, uint32_t seed, const GeneratorOptions& opts) {
     universe::Universe u;
-    std::mt19937 rng(seed);
+    u.set_seed(seed);
+    auto& gates = u.gates();
+    const universe::FreezeOptions freeze_opts{.threads = opts.threads};
+    if (system_count < 1) {
+        gates.freeze(freeze_opts);
+        return u;
+    }
 
-    std::uniform_int_distribution<int> pct(0, 99);
-    std::uniform_int_distribution<int> pick_id(1, system_count);
+    // Every random draw below comes from CounterRng(seed, stream, index) and
+    // is made in a parallel pass; the sequential passes only assemble the
+    // draws in a fixed order. The result is therefore identical for any
+    // thread count.
+    const auto n = static_cast<size_t>(system_count);
+    const Parallel par{opts.threads};
 
     // -----------------------------
     // 1) Create systems
     // -----------------------------
-    for (int i = 0; i < system_count; ++i) {
+    // Positions: uniform over the disk (r = R * sqrt(u) keeps density even).
+    const float disk_radius = kSpacingLy * std::sqrt(static_cast<float>(n) / std::numbers::pi_v<float>);
+    std::vector<uint8_t> roll(n);
+    std::vector<universe::Vec3> pos(n);
+    par(n, [&](size_t i) {
+        roll[i] = static_cast<uint8_t>(util::CounterRng(seed, kAttributes, i).uniform(100));
+
+        util::CounterRng r(seed, kPosition, i);
+        float radius = disk_radius * static_cast<float>(std::sqrt(r.unit()));
+        float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(r.unit());
+        float z = kDiskThicknessLy * (static_cast<float>(r.unit()) - 0.5f);
+        pos[i] = {radius * std::cos(angle), radius * std::sin(angle), z};
+    });
+
+    const size_t name_width = std::max<size_t>(4, digit_count(system_count));
+    for (size_t i = 0; i < n; ++i) {
         universe::SolarSystem s;
-        s.id = i + 1;
-        s.name = sys_name(i + 1);
+        s.id = static_cast<SystemId>(i + 1);
+        s.name = sys_name(s.id, name_width);
 
-        int r = pct(rng);        
+        int r = roll[i];
         if (r < 15) {
             s.type = universe::SystemType::Core;
             s.security = universe::SecurityLevel::High;
@@ -44,40 +414,35 @@ universe::Universe generate_universe(int system_count, uint32_t seed) {
         }
 
         s.owner_faction_id = 0;
+        s.position = pos[i];
         u.add_system(std::move(s));
     }
-
-    auto& gates = u.gates();
+    u.build_spatial_index();
 
     // -----------------------------
-    // 2) Build a spanning tree (guaranteed connectivity)
+    // 2) Gates
     // -----------------------------
-    std::vector<SystemId> ids;
-    ids.reserve(system_count);
-    for (int i = 0; i < system_count; ++i) {
-        ids.push_back(i + 1);
-    }
-
-    std::shuffle(ids.begin(), ids.end(), rng);
-
-    for (size_t i = 1; i < ids.size(); ++i) {
-        SystemId a = pick_id(rng);
-        SystemId b = pick_id(rng);
-        gates.add_gate(a, b);
+    if (n > 1) {
+        GateBuilder gb{gates, std::vector<uint8_t>(n, 0)};
+        if (opts.layout == GateLayout::Spatial) {
+            build_spatial_gates(gb, u, seed, par);
+        } else {
+            build_random_gates(gb, n, seed, par);
+        }
     }
 
     // -----------------------------
-    // 3) Add extra random gates (web, shortcuts)
+    // 3) Verify connectivity
     // -----------------------------
-    int extra_edges = system_count / 8; 
-    for (int i = 0; i < extra_edges; ++i) {
-        SystemId a = (rng() % system_count) + 1;
-        SystemId b = (rng() % system_count) + 1;
-        if (a != b) {
-            gates.add_gate(a, b);
+    // The union-find makes this O(1); the tree guarantees it, but stitch
+    // any stray component to its predecessor rather than ship a broken map.
+    if (!gates.is_connected()) {
+        for (int i = 2; i <= system_count; ++i) {
+            if (gates.component_of(i) != gates.component_of(i - 1)) gates.add_gate(i - 1, i);
         }
     }
 
+    gates.freeze(freeze_opts);
     return u;
 }
 
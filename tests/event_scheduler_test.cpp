@@ -0,0 +1,130 @@
+// The timing wheel against an ordered map: random schedule / cancel /
+// advance sequences, with horizons reaching every level and the overflow
+// list, must fire the same events on the same ticks in the same order.
+// Then the handler cases: cancelling and scheduling from inside a handler.
+#include "event_scheduler.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok && failures++ < 20) std::printf("FAIL: %s\n", what);
+}
+
+struct Fired {
+    int64_t tick;
+    uint64_t payload;
+    bool operator==(const Fired&) const = default;
+};
+
+void randomized() {
+    constexpr int64_t kStep = 600;
+    sim::EventScheduler s(kStep);
+    std::vector<Fired> fired;
+    sim::EventKind kind = s.add_kind("test", [&](const sim::ScheduledEvent& ev) { fired.push_back({ev.tick, ev.payload}); });
+
+    std::map<std::pair<int64_t, uint64_t>, uint64_t> want; // (due tick, seq) -> payload
+    struct Live {
+        sim::EventHandle h;
+        int64_t due;
+        uint64_t seq;
+    };
+    std::vector<Live> handles; // every handle ever issued, live or stale
+    std::mt19937_64 rng(42);
+    int64_t now = 0;
+    uint64_t seq = 0;
+
+    auto horizon = [&]() -> int64_t {
+        uint64_t r = rng() % 1000;
+        if (r < 600) return static_cast<int64_t>(rng() % 300);                  // level 0-1
+        if (r < 850) return static_cast<int64_t>(rng() % 70000);                // level 1-2
+        if (r < 950) return static_cast<int64_t>(rng() % (int64_t{1} << 24));   // level 2-3
+        if (r < 995) return static_cast<int64_t>(rng() % (int64_t{1} << 25));   // level 3
+        return (int64_t{1} << 32) + static_cast<int64_t>(rng() % 1000);         // overflow list
+    };
+
+    constexpr int kOps = 200000;
+    for (int op = 0; op < kOps; ++op) {
+        uint64_t r = rng() % 100;
+        if (r < 50) {
+            // Seconds around the target tick, sometimes already in the past.
+            int64_t at = (now + horizon()) * kStep + static_cast<int64_t>(rng() % (2 * kStep)) - kStep;
+            int64_t due = at > 0 ? (at + kStep - 1) / kStep : 0;
+            due = std::max(due, now + 1);
+            sim::EventHandle h = s.schedule_at(at, kind, seq);
+            want[{due, seq}] = seq;
+            handles.push_back({h, due, seq});
+            ++seq;
+        } else if (r < 70) {
+            if (handles.empty()) continue;
+            const Live& l = handles[rng() % handles.size()];
+            bool live = want.count({l.due, l.seq}) > 0;
+            check(s.pending(l.h) == live, "pending() disagrees with the reference");
+            check(s.cancel(l.h) == live, "cancel() disagrees with the reference");
+            want.erase({l.due, l.seq});
+        } else {
+            int64_t step = 1 + static_cast<int64_t>(rng() % 256);
+            if (rng() % 1000 < 29) step = 1 + static_cast<int64_t>(rng() % 131072);
+            if (op % 50000 == 49999) step = (int64_t{1} << 24) + static_cast<int64_t>(rng() % 100000);
+            now += step;
+            fired.clear();
+            s.advance_to(now);
+
+            std::vector<Fired> expect;
+            while (!want.empty() && want.begin()->first.first <= now) {
+                expect.push_back({want.begin()->first.first, want.begin()->second});
+                want.erase(want.begin());
+            }
+            check(fired == expect, "fired events differ from the reference");
+        }
+        check(s.pending_count() == want.size(), "pending_count() differs from the reference");
+    }
+    check(s.current_tick() == now, "current_tick() is not the last advanced tick");
+}
+
+void handlers() {
+    sim::EventScheduler s(1);
+    std::vector<uint64_t> fired;
+    sim::EventHandle victim, reused;
+    sim::EventKind plain = s.add_kind("plain", [&](const sim::ScheduledEvent& ev) { fired.push_back(ev.payload); });
+    sim::EventKind killer = s.add_kind("killer", [&](const sim::ScheduledEvent& ev) {
+        fired.push_back(ev.payload);
+        check(s.cancel(victim), "cancel from a handler");
+        // Likely reuses the victim's node: it must not fire in this tick's batch.
+        reused = s.schedule_at(ev.tick, plain, 4);
+        s.schedule_at(ev.tick + 5, plain, 5);
+    });
+
+    s.schedule_at(10, killer, 1);
+    victim = s.schedule_at(10, plain, 2); // same tick, later in order
+    s.schedule_at(10, plain, 3);
+
+    s.advance_to(10);
+    check(fired == std::vector<uint64_t>({1, 3}), "cancelled event fired, or order changed");
+    check(!s.pending(victim), "cancelled handle still pending");
+    check(s.pending(reused), "event scheduled from a handler is pending");
+    check(!s.cancel(victim), "second cancel of a stale handle succeeded");
+
+    s.advance_to(11);
+    check(fired == std::vector<uint64_t>({1, 3, 4}), "event scheduled for the current tick fires on the next");
+    s.advance_to(20);
+    check(fired == std::vector<uint64_t>({1, 3, 4, 5}), "event scheduled from a handler fires on its tick");
+    check(s.pending_count() == 0 && s.fired_count() == 4, "counts after the handler case");
+}
+
+} // namespace
+
+int main() {
+    randomized();
+    handlers();
+    if (failures == 0) std::printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
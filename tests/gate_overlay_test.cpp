@@ -0,0 +1,80 @@
+// A GateOverlay built before an edit must keep meaning the same systems and
+// gates after the network refreezes.
+#include "universe/gate_network.h"
+#include "universe/gate_overlay.h"
+
+#include <cstdio>
+#include <vector>
+
+using universe::EdgeIndex;
+using universe::GateNetwork;
+using universe::GateOverlay;
+using universe::NodeIndex;
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        ++failures;
+    }
+}
+
+int jumps(const GateNetwork& g, int a, int b, const GateOverlay* ov) {
+    auto r = g.shortest_route(a, b, ov);
+    return r ? r->jumps : -1;
+}
+
+// Each gate id in [0, gate_count) is used by exactly its two half-edges.
+bool edge_ids_valid(const GateNetwork& g) {
+    std::vector<int> uses(static_cast<size_t>(g.gate_count()), 0);
+    for (NodeIndex i = 0; i < g.node_count(); ++i) {
+        for (EdgeIndex e : g.dense_edges(i)) {
+            if (e < 0 || e >= g.gate_count()) return false;
+            ++uses[static_cast<size_t>(e)];
+        }
+    }
+    for (int u : uses) {
+        if (u != 2) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    // 4-cycle 1-2-3-4-1 with gate 3-4 closed.
+    GateNetwork g;
+    g.add_gate(1, 2);
+    g.add_gate(2, 3);
+    g.add_gate(3, 4);
+    g.add_gate(4, 1);
+    g.freeze();
+
+    GateOverlay ov(g);
+    check(ov.close_gate(g, 3, 4), "close_gate 3-4");
+    auto closed = g.edge_index(3, 4);
+    check(jumps(g, 3, 4, &ov) == 3, "route around the closed gate before the edit");
+
+    // An edit that lands a new gate in front of 3-4 in node order.
+    check(g.add_gate(1, 3), "add_gate 1-3");
+    check(g.frozen(), "network refrozen after the edit");
+    check(g.edge_index(3, 4) == closed, "gate 3-4 kept its id");
+    check(edge_ids_valid(g), "gate ids are unique and dense");
+    check(jumps(g, 3, 4, &ov) == 2, "closed gate still closed after the edit");
+    check(jumps(g, 1, 3, &ov) == 1, "new gate starts open");
+
+    // New systems start enabled; closed ones stay closed.
+    check(ov.close_system(g, 2), "close_system 2");
+    g.add_gate(5, 2);
+    g.add_gate(5, 4);
+    check(edge_ids_valid(g), "gate ids valid after adding a system");
+    check(jumps(g, 1, 2, &ov) == -1, "closed system still closed");
+    check(jumps(g, 3, 5, &ov) == 3, "route through the new system avoids the closed gate");
+    check(jumps(g, 3, 4, nullptr) == 1, "no overlay: gate 3-4 is open");
+
+    if (failures == 0) std::printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+// Corrupted snapshots must be rejected, not trusted: each case damages one
+// field, fixes up the checksum so only the structural checks can catch it,
+// and expects load_snapshot to fail.
+#include "universe/snapshot.h"
+#include "universe_generator.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+// On-disk layout, mirrored from snapshot.cpp.
+constexpr size_t kHeaderSize = 56;
+constexpr size_t kChecksumAt = 32;
+constexpr size_t kEntrySize = 24;
+enum : uint32_t { kSystemTypes = 1, kSystemSecurity = 2, kNameSlots = 10, kGateIds = 12, kGateTargets = 14 };
+
+using Bytes = std::vector<unsigned char>;
+
+uint32_t u32(const Bytes& b, size_t at) {
+    uint32_t v;
+    std::memcpy(&v, b.data() + at, 4);
+    return v;
+}
+uint64_t u64(const Bytes& b, size_t at) {
+    uint64_t v;
+    std::memcpy(&v, b.data() + at, 8);
+    return v;
+}
+
+size_t entry_at(uint32_t section) { return kHeaderSize + section * kEntrySize; }
+size_t elem_size_at(uint32_t section) { return entry_at(section) + 4; }
+size_t data_at(const Bytes& b, uint32_t section) { return u64(b, entry_at(section) + 8); }
+size_t count_of(const Bytes& b, uint32_t section) { return u64(b, entry_at(section) + 16); }
+
+void rechecksum(Bytes& b) {
+    uint64_t h = 1469598103934665603ull;
+    size_t i = kHeaderSize;
+    for (; i + 8 <= b.size(); i += 8) h = (h ^ u64(b, i)) * 1099511628211ull;
+    for (; i < b.size(); ++i) h = (h ^ b[i]) * 1099511628211ull;
+    std::memcpy(b.data() + kChecksumAt, &h, 8);
+}
+
+Bytes read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return Bytes(std::istreambuf_iterator<char>(in), {});
+}
+
+void write_file(const std::string& path, const Bytes& b) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(b.data()), static_cast<std::streamsize>(b.size()));
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "snapshot_test.snap";
+    universe::Universe u = sim::generate_universe(200, 7);
+    if (!universe::save_snapshot(u, path)) {
+        std::printf("FAIL: save_snapshot\n");
+        return 1;
+    }
+    const Bytes good = read_file(path);
+
+    struct Case {
+        const char* name;
+        std::function<void(Bytes&)> damage;
+    };
+    const Case cases[] = {
+        {"intact", [](Bytes&) {}},
+        {"elem_size", [](Bytes& b) { b[elem_size_at(kNameSlots)] = 1; }},
+        {"system_type", [](Bytes& b) { b[data_at(b, kSystemTypes)] = 3; }},
+        {"security_level", [](Bytes& b) { b[data_at(b, kSystemSecurity)] = 4; }},
+        {"slot_table_size", [](Bytes& b) { b[entry_at(kNameSlots) + 16] ^= 1; }},
+        {"slot_table_full",
+         [](Bytes& b) {
+             size_t at = data_at(b, kNameSlots);
+             for (size_t i = 0; i < count_of(b, kNameSlots); ++i, at += 4) {
+                 if (u32(b, at) == 0) b[at] = 1;
+             }
+         }},
+        {"one_way_gate",
+         [](Bytes& b) {
+             // Point the first half-edge at a different system: its reverse is gone.
+             size_t at = data_at(b, kGateTargets);
+             b[at] ^= (b[at] ^ 1) == 0 ? 2 : 1;
+         }},
+        {"unknown_gate_system", [](Bytes& b) { b[data_at(b, kGateIds) + 3] = 0x40; }},
+    };
+
+    int failures = 0;
+    for (const Case& c : cases) {
+        Bytes b = good;
+        c.damage(b);
+        rechecksum(b);
+        write_file(path, b);
+        std::string error;
+        bool loaded = universe::load_snapshot(path, {}, &error).has_value();
+        bool want = std::strcmp(c.name, "intact") == 0;
+        if (loaded != want) {
+            std::printf("FAIL: %s: %s\n", c.name, loaded ? "loaded" : error.c_str());
+            ++failures;
+        }
+    }
+    std::remove(path.c_str());
+    if (failures == 0) std::printf("ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+// Phase registration stays cheap with long periods next to an every-tick
+// phase, and the phases it spreads out actually run on their schedule.
+#include "tick_scheduler.h"
+#include "time/game_time.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+int main() {
+    using Clock = std::chrono::steady_clock;
+    constexpr int64_t kStep = 600;
+    const int64_t year = time_sim::days_to_seconds(365);
+    const int64_t year_ticks = year / kStep;
+
+    sim::TickScheduler s(kStep);
+    std::vector<uint64_t> runs(4, 0);
+    auto count = [&](int i) { return [&runs, i](const sim::TickContext&) { ++runs[static_cast<size_t>(i)]; }; };
+
+    auto t0 = Clock::now();
+    int fast = s.add_phase({"fast", kStep, 30, 1}, count(0));
+    int yearly = s.add_phase({"yearly", year, 0, 1}, count(1));
+    int yearly_sliced = s.add_phase({"yearly_sliced", year, 0, 73}, count(2));
+    int daily = s.add_phase({"daily", time_sim::days_to_seconds(1), 10, 12}, count(3));
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        if (!ok) {
+            std::printf("FAIL: %s\n", what);
+            ++failures;
+        }
+    };
+    check(fast >= 0 && yearly >= 0 && yearly_sliced >= 0 && daily >= 0, "add_phase rejected a valid phase");
+    check(ms < 1000, "add_phase took over a second");
+
+    // The two yearly phases should not share their first tick.
+    int64_t yearly_offset = -1, sliced_offset = -1;
+    for (const sim::PhaseStats& p : s.stats()) {
+        if (p.name == "yearly") yearly_offset = p.offset_ticks;
+        if (p.name == "yearly_sliced") sliced_offset = p.offset_ticks;
+    }
+    check(yearly_offset != sliced_offset, "yearly phases share an offset");
+
+    for (int64_t t = 0; t < year_ticks; ++t) s.run_tick(t, t * kStep);
+    check(runs[0] == static_cast<uint64_t>(year_ticks), "fast phase missed ticks");
+    check(runs[1] == 1, "yearly phase did not run exactly once");
+    check(runs[2] == 73, "sliced yearly phase did not run every slice");
+    check(runs[3] == 365 * 12, "daily phase did not run every slice");
+
+    if (failures == 0) std::printf("ok (%.2f ms to register)\n", ms);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+#include "universe_generator.h"
+#include "universe/gate_network.h"
+#include "universe/route_planner.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+using universe::GateNetwork;
+using universe::SystemId;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+struct RunStats {
+    double ms = 0.0;
+    long long checksum = 0; // sum of jumps / hits, keeps the work observable
+};
+
+RunStats bench_routes(const GateNetwork& g, const std::vector<std::pair<SystemId, SystemId>>& pairs) {
+    RunStats st;
+    auto t0 = Clock::now();
+    for (const auto& [a, b] : pairs) {
+        auto rr = g.shortest_route(a, b);
+        if (rr) st.checksum += rr->jumps;
+    }
+    st.ms = ms_since(t0);
+    return st;
+}
+
+// Every route the index returns must be a real walk from a to b with as
+// many jumps as the bidirectional BFS found.
+bool routes_match(const GateNetwork& indexed, const GateNetwork& bfs,
+                  const std::vector<std::pair<SystemId, SystemId>>& pairs) {
+    for (const auto& [a, b] : pairs) {
+        auto got = indexed.shortest_route(a, b);
+        auto want = bfs.shortest_route(a, b);
+        if (got.has_value() != want.has_value()) return false;
+        if (!got) continue;
+        if (got->jumps != want->jumps || got->path.size() != static_cast<size_t>(got->jumps) + 1) return false;
+        if (got->path.front() != a || got->path.back() != b) return false;
+        for (size_t i = 1; i < got->path.size(); ++i) {
+            if (!indexed.has_gate(got->path[i - 1], got->path[i])) return false;
+        }
+    }
+    return true;
+}
+
+RunStats bench_within(const GateNetwork& g, const std::vector<std::pair<SystemId, SystemId>>& pairs, int jumps) {
+    RunStats st;
+    auto t0 = Clock::now();
+    for (const auto& [a, b] : pairs) {
+        (void)b;
+        st.checksum += static_cast<long long>(g.within(a, jumps).size());
+    }
+    st.ms = ms_since(t0);
+    return st;
+}
+
+// Baseline for the planner: textbook Dijkstra on a binary heap, same costs.
+long long dijkstra_cost(const GateNetwork& g, const universe::RoutePlanner& p, SystemId a, SystemId b) {
+    auto s = g.index_of(a);
+    auto t = g.index_of(b);
+    if (!s || !t) return -1;
+
+    using Item = std::pair<uint64_t, universe::NodeIndex>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> pq;
+    std::vector<uint64_t> dist(static_cast<size_t>(g.node_count()), UINT64_MAX);
+    dist[static_cast<size_t>(*s)] = 0;
+    pq.emplace(0, *s);
+
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (d != dist[static_cast<size_t>(u)]) continue;
+        if (u == *t) return static_cast<long long>(d);
+        for (universe::NodeIndex v : g.dense_neighbors(u)) {
+            if (!p.enterable(v, *t)) continue;
+            uint64_t nd = d + p.edge_cost(u, v);
+            if (nd < dist[static_cast<size_t>(v)]) {
+                dist[static_cast<size_t>(v)] = nd;
+                pq.emplace(nd, v);
+            }
+        }
+    }
+    return -1;
+}
+
+RunStats bench_weighted(const std::function<long long(SystemId, SystemId)>& fn,
+                        const std::vector<std::pair<SystemId, SystemId>>& pairs) {
+    RunStats st;
+    auto t0 = Clock::now();
+    for (const auto& [a, b] : pairs) {
+        long long c = fn(a, b);
+        if (c >= 0) st.checksum += c;
+    }
+    st.ms = ms_since(t0);
+    return st;
+}
+
+void report(const char* label, const RunStats& st, size_t queries) {
+    std::cout << "  " << label << ": " << st.ms << " ms total, "
+              << (st.ms * 1000.0 / static_cast<double>(queries)) << " us/query"
+              << " (checksum " << st.checksum << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int size = 500;
+    uint32_t seed = 1337;
+    int queries = 100000;
+    int within_jumps = 3;
+    sim::GeneratorOptions opts;
+
+    // Simple args: --size N --seed S --queries Q --within J --spatial
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--size" && has_value) size = std::atoi(argv[++i]);
+        else if (a == "--seed" && has_value) seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (a == "--queries" && has_value) queries = std::atoi(argv[++i]);
+        else if (a == "--within" && has_value) within_jumps = std::atoi(argv[++i]);
+        else if (a == "--spatial") opts.layout = sim::GateLayout::Spatial;
+        else size = -1;
+    }
+    if (size < 2 || queries < 1) {
+        std::cerr << "usage: route_bench [--size N] [--seed S] [--queries Q] [--within J] [--spatial]\n";
+        return 2;
+    }
+    const bool spatial = opts.layout == sim::GateLayout::Spatial;
+
+    auto t0 = Clock::now();
+    universe::Universe u = sim::generate_universe(size, seed, opts);
+    std::cout << "Generated " << size << " systems (seed " << seed << ", " << (spatial ? "spatial" : "random")
+              << ") in " << ms_since(t0) << " ms\n";
+
+    GateNetwork bfs = u.gates();
+    bfs.freeze({.route_table = false, .region_index = false});
+
+    // The table is 2*N*N bytes: keep freeze()'s default size limit.
+    GateNetwork table = u.gates();
+    t0 = Clock::now();
+    table.freeze({.route_table = true, .region_index = false});
+    double build_ms = ms_since(t0);
+
+    if (!table.route_table()) {
+        std::cout << "Route table unavailable (over " << universe::FreezeOptions{}.route_table_max_nodes
+                  << " systems, or diameter or degree exceeds 254); BFS only.\n";
+    } else {
+        std::cout << "Route table: " << table.route_table()->memory_bytes() / 1024 << " KB, built in "
+                  << build_ms << " ms\n";
+    }
+
+    // Forced regardless of size; freeze() still declines small-world graphs
+    // (the random layout), so use --spatial to exercise it.
+    GateNetwork regions = u.gates();
+    t0 = Clock::now();
+    regions.freeze({.route_table = false, .region_index = true, .region_index_min_nodes = 0});
+    build_ms = ms_since(t0);
+
+    if (!regions.region_index()) {
+        std::cout << "Region index unavailable (small diameter or no locality"
+                  << (spatial ? "" : "; try --spatial") << "); BFS only.\n";
+    } else {
+        const auto* ri = regions.region_index();
+        std::cout << "Region index: " << ri->region_count() << " regions, " << ri->border_count() << " borders, "
+                  << ri->memory_bytes() / 1024 << " KB, built in " << build_ms << " ms\n";
+    }
+
+    std::mt19937 rng(seed ^ 0x9e3779b9u);
+    std::uniform_int_distribution<int> pick(0, bfs.node_count() - 1);
+    std::vector<std::pair<SystemId, SystemId>> pairs;
+    pairs.reserve(static_cast<size_t>(queries));
+    for (int i = 0; i < queries; ++i) {
+        pairs.emplace_back(bfs.id_at(pick(rng)), bfs.id_at(pick(rng)));
+    }
+
+    // "bfs" is the plain bidirectional BFS; the indexes are checked against it.
+    std::cout << "shortest_route x" << queries << ":\n";
+    RunStats r_bfs = bench_routes(bfs, pairs);
+    report("bfs  ", r_bfs, pairs.size());
+    if (table.route_table()) {
+        RunStats r_tab = bench_routes(table, pairs);
+        report("table", r_tab, pairs.size());
+        if (r_tab.checksum != r_bfs.checksum) {
+            std::cerr << "MISMATCH: table and BFS disagree on jump counts\n";
+            return 1;
+        }
+    }
+    if (regions.region_index()) {
+        RunStats r_reg = bench_routes(regions, pairs);
+        report("region", r_reg, pairs.size());
+        if (r_reg.checksum != r_bfs.checksum || !routes_match(regions, bfs, pairs)) {
+            std::cerr << "MISMATCH: region index and BFS disagree on routes\n";
+            return 1;
+        }
+    }
+
+    std::cout << "within(" << within_jumps << ") x" << queries << ":\n";
+    RunStats w_bfs = bench_within(bfs, pairs, within_jumps);
+    report("bfs  ", w_bfs, pairs.size());
+
+    universe::RouteCostProfile profile;
+    profile.avoid_lawless = true;
+    t0 = Clock::now();
+    universe::RoutePlanner planner(u, profile);
+    std::cout << "Route planner: " << planner.landmark_count() << " landmarks in " << ms_since(t0) << " ms\n";
+
+    std::cout << "weighted route x" << queries << ":\n";
+    RunStats d_bin = bench_weighted([&](SystemId a, SystemId b) { return dijkstra_cost(u.gates(), planner, a, b); }, pairs);
+    report("dijkstra", d_bin, pairs.size());
+    RunStats d_alt = bench_weighted([&](SystemId a, SystemId b) {
+        auto wr = planner.route(a, b);
+        return wr ? static_cast<long long>(wr->cost) : -1LL;
+    }, pairs);
+    report("a*/alt  ", d_alt, pairs.size());
+    if (d_alt.checksum != d_bin.checksum) {
+        std::cerr << "MISMATCH: planner and Dijkstra disagree on route costs\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include "universe_generator.h"
+#include "universe/gate_analytics.h"
+#include "universe/gate_network.h"
+
+#include "json.hpp"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+using universe::GateNetwork;
+using universe::NodeIndex;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Peak resident set size of the process so far, in KB (Linux reports KB).
+long peak_rss_kb() {
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+}
+
+// Exact diameter only up to this size; above it the double-sweep bound.
+constexpr int kExactDiameterMax = 20000;
+
+// Farthest node from `src` and its distance (plain BFS over the CSR).
+std::pair<NodeIndex, int> farthest(const GateNetwork& g, NodeIndex src) {
+    std::vector<int32_t> dist(static_cast<size_t>(g.node_count()), -1);
+    std::vector<NodeIndex> queue{src};
+    dist[static_cast<size_t>(src)] = 0;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        NodeIndex u = queue[head];
+        for (NodeIndex v : g.dense_neighbors(u)) {
+            if (dist[static_cast<size_t>(v)] != -1) continue;
+            dist[static_cast<size_t>(v)] = dist[static_cast<size_t>(u)] + 1;
+            queue.push_back(v);
+        }
+    }
+    return {queue.back(), dist[static_cast<size_t>(queue.back())]};
+}
+
+// Largest eccentricity, exact for small networks (bit-parallel BFS from
+// every node), otherwise a double sweep from a few starts, which is a
+// lower bound and in practice tight on sparse graphs.
+int diameter(const GateNetwork& g, bool& exact) {
+    const int n = g.node_count();
+    int best = 0;
+    exact = n <= kExactDiameterMax;
+    if (exact) {
+        std::vector<NodeIndex> all(static_cast<size_t>(n));
+        for (int i = 0; i < n; ++i) all[static_cast<size_t>(i)] = i;
+        for (int s = 0; s < n; s += universe::kBatchLanes) {
+            int count = std::min(universe::kBatchLanes, n - s);
+            auto m = universe::batch_jump_distances(g, std::span(all).subspan(static_cast<size_t>(s), static_cast<size_t>(count)), all);
+            for (int32_t d : m.jumps) best = std::max(best, d);
+        }
+        return best;
+    }
+    std::mt19937 rng(12345);
+    for (int sweep = 0; sweep < 4; ++sweep) {
+        auto a = farthest(g, static_cast<NodeIndex>(rng() % static_cast<uint32_t>(n)));
+        auto b = farthest(g, a.first);
+        best = std::max(best, b.second);
+    }
+    return best;
+}
+
+struct JumpSample {
+    size_t pairs = 0;       // reachable pairs sampled
+    size_t unreachable = 0;
+    double mean = 0;
+    int max = 0;
+};
+
+// Jumps between random sources and random targets drawn from `pool`.
+JumpSample sample_jumps(const GateNetwork& g, const std::vector<NodeIndex>& pool, int samples, std::mt19937& rng) {
+    JumpSample out;
+    if (pool.size() < 2) return out;
+    std::uniform_int_distribution<size_t> pick(0, pool.size() - 1);
+    std::vector<NodeIndex> sources(static_cast<size_t>(samples)), targets(static_cast<size_t>(samples));
+    for (auto& s : sources) s = pool[pick(rng)];
+    for (auto& t : targets) t = pool[pick(rng)];
+
+    auto m = universe::batch_jump_distances(g, sources, targets);
+    double sum = 0;
+    for (size_t i = 0; i < m.jumps.size(); ++i) {
+        if (sources[i / targets.size()] == targets[i % targets.size()]) continue;
+        int32_t d = m.jumps[i];
+        if (d < 0) { ++out.unreachable; continue; }
+        ++out.pairs;
+        sum += d;
+        out.max = std::max(out.max, d);
+    }
+    if (out.pairs > 0) out.mean = sum / static_cast<double>(out.pairs);
+    return out;
+}
+
+json jump_json(const JumpSample& s) {
+    return {{"pairs", s.pairs}, {"unreachable", s.unreachable}, {"mean", s.mean}, {"max", s.max}};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int size = 500;
+    uint32_t seed = 1337;
+    int samples = 256; // sources x targets per jump sample
+    sim::GeneratorOptions opts;
+    bool as_json = false;
+
+    // Simple args: --size N --seed S --threads T --samples K --spatial --json
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        bool has_value = i + 1 < argc;
+        if (a == "--size" && has_value) size = std::atoi(argv[++i]);
+        else if (a == "--seed" && has_value) seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (a == "--threads" && has_value) opts.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (a == "--samples" && has_value) samples = std::atoi(argv[++i]);
+        else if (a == "--spatial") opts.layout = sim::GateLayout::Spatial;
+        else if (a == "--json") as_json = true;
+        else size = -1;
+    }
+    if (size < 2 || samples < 1) {
+        std::cerr << "usage: universe_stats [--size N] [--seed S] [--threads T] [--samples K] [--spatial] [--json]\n";
+        return 2;
+    }
+
+    const long rss_before_kb = peak_rss_kb();
+    auto t0 = Clock::now();
+    universe::Universe u = sim::generate_universe(size, seed, opts);
+    const double gen_ms = ms_since(t0);
+    const long rss_after_kb = peak_rss_kb();
+
+    const GateNetwork& g = u.gates();
+    const int n = g.node_count();
+
+    // Degree distribution.
+    std::vector<size_t> degree_hist;
+    size_t in_target = 0; // systems with 2-4 gates
+    for (NodeIndex i = 0; i < n; ++i) {
+        size_t d = g.dense_neighbors(i).size();
+        if (d >= degree_hist.size()) degree_hist.resize(d + 1, 0);
+        ++degree_hist[d];
+        if (d >= 2 && d <= 4) ++in_target;
+    }
+    const double mean_degree = 2.0 * g.gate_count() / n;
+
+    t0 = Clock::now();
+    bool diameter_exact = false;
+    const int diam = diameter(g, diameter_exact);
+    const double diameter_ms = ms_since(t0);
+
+    std::mt19937 rng(seed ^ 0x9e3779b9u);
+    std::vector<NodeIndex> all(static_cast<size_t>(n)), core;
+    for (NodeIndex i = 0; i < n; ++i) {
+        all[static_cast<size_t>(i)] = i;
+        auto di = u.dense_index(g.id_at(i));
+        if (di && u.types()[*di] == universe::SystemType::Core) core.push_back(i);
+    }
+    t0 = Clock::now();
+    JumpSample any = sample_jumps(g, all, samples, rng);
+    JumpSample inter_core = sample_jumps(g, core, samples, rng);
+    const double jumps_ms = ms_since(t0);
+
+    t0 = Clock::now();
+    auto choke = universe::find_chokepoints(g);
+    const double choke_ms = ms_since(t0);
+
+    if (as_json) {
+        json degrees = json::object();
+        for (size_t d = 0; d < degree_hist.size(); ++d) {
+            if (degree_hist[d] > 0) degrees[std::to_string(d)] = degree_hist[d];
+        }
+        json out = {
+            {"size", size},
+            {"seed", seed},
+            {"layout", opts.layout == sim::GateLayout::Spatial ? "spatial" : "random"},
+            {"gates", g.gate_count()},
+            {"generate_ms", gen_ms},
+            {"peak_rss_kb", rss_after_kb},
+            {"generate_rss_kb", rss_after_kb - rss_before_kb},
+            {"degree", {{"mean", mean_degree}, {"share_2_to_4", static_cast<double>(in_target) / n}, {"histogram", degrees}}},
+            {"diameter", {{"jumps", diam}, {"exact", diameter_exact}, {"ms", diameter_ms}}},
+            {"jumps", {{"random_pairs", jump_json(any)}, {"inter_core", jump_json(inter_core)}, {"ms", jumps_ms}}},
+            {"components", g.component_count()},
+            {"chokepoints", {{"articulation_points", choke.articulation_points.size()}, {"bridges", choke.bridges.size()}, {"ms", choke_ms}}},
+        };
+        std::cout << out.dump(2) << "\n";
+        return 0;
+    }
+
+    std::cout << "Generated " << size << " systems, " << g.gate_count() << " gates (seed " << seed << ", "
+              << (opts.layout == sim::GateLayout::Spatial ? "spatial" : "random") << ") in " << gen_ms << " ms\n";
+    std::cout << "Peak RSS: " << rss_after_kb / 1024 << " MB (+" << (rss_after_kb - rss_before_kb) / 1024
+              << " MB while generating)\n";
+    std::cout << "Degree: mean " << mean_degree << ", " << 100.0 * static_cast<double>(in_target) / n
+              << "% of systems have 2-4 gates\n";
+    for (size_t d = 0; d < degree_hist.size(); ++d) {
+        if (degree_hist[d] > 0) std::cout << "  " << d << ": " << degree_hist[d] << "\n";
+    }
+    std::cout << "Diameter: " << diam << " jumps (" << (diameter_exact ? "exact" : "double-sweep lower bound")
+              << ", " << diameter_ms << " ms)\n";
+    std::cout << "Average jumps, random pairs: " << any.mean << " (max " << any.max << ", " << any.pairs
+              << " pairs, " << any.unreachable << " unreachable)\n";
+    std::cout << "Average jumps, core to core: " << inter_core.mean << " (max " << inter_core.max << ", "
+              << inter_core.pairs << " pairs, " << core.size() << " core systems)\n";
+    std::cout << "Components: " << g.component_count() << "\n";
+    std::cout << "Chokepoints: " << choke.articulation_points.size() << " systems, " << choke.bridges.size()
+              << " bridge gates (" << choke_ms << " ms)\n";
+    return 0;
+}